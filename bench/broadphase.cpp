@@ -0,0 +1,107 @@
+#include "raylib.h"
+#include "raymath.h"
+
+#include <vector>
+#include <random>
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+
+#include "config.h"
+#include "spatial_grid.h"
+
+// Player shots vs destructibles: brute force O(P x D) against the uniform grid
+// with the linear fallback disabled. Grid timings include the per-tick rebuild.
+// Prints CSV and the smallest destructible count at which the grid wins for
+// each shot count, which is what BROADPHASE_GRID_MIN_ITEMS is tuned from.
+
+constexpr float BENCH_SHOT_RADIUS = 8.0f;
+constexpr float BENCH_DESTRUCTIBLE_RADIUS = 12.0f;
+constexpr int BENCH_TICKS = 2000;
+
+struct Circles {
+	std::vector<Vector2> position;
+	std::vector<float> radius;
+};
+
+static Circles random_circles(std::mt19937& rng, size_t count, float radius) {
+	std::uniform_real_distribution<float> x(KILLING_FIELD_TOP_LEFT.x, KILLING_FIELD_BOTTOM_RIGHT.x);
+	std::uniform_real_distribution<float> y(KILLING_FIELD_TOP_LEFT.y, KILLING_FIELD_BOTTOM_RIGHT.y);
+	Circles circles;
+	for (size_t i = 0; i < count; i++) {
+		circles.position.push_back(Vector2{ x(rng), y(rng) });
+		circles.radius.push_back(radius);
+	}
+	return circles;
+}
+
+static inline bool overlap(Vector2 a, float ra, Vector2 b, float rb) {
+	float r = ra + rb;
+	return Vector2DistanceSqr(a, b) < r * r;
+}
+
+template <typename F>
+static double ns_per_tick(F tick) {
+	auto start = std::chrono::steady_clock::now();
+	for (int i = 0; i < BENCH_TICKS; i++) tick();
+	auto stop = std::chrono::steady_clock::now();
+	return double(std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count()) / BENCH_TICKS;
+}
+
+int main(void) {
+	const size_t shot_counts[] = { 16, 64, 256, 1024 };
+	const size_t destructible_counts[] = { 1, 2, 4, 8, 16, 32, 64, 128, 256, 512 };
+
+	std::mt19937 rng(1234);
+	SpatialGrid<uint32_t> grid;
+	grid.min_grid_items = 0;
+	volatile size_t sink = 0;
+
+	std::printf("shots,destructibles,brute_ns,grid_ns\n");
+	for (size_t shots : shot_counts) {
+		size_t crossover = 0;
+		for (size_t destructibles : destructible_counts) {
+			Circles s = random_circles(rng, shots, BENCH_SHOT_RADIUS);
+			Circles d = random_circles(rng, destructibles, BENCH_DESTRUCTIBLE_RADIUS);
+
+			double brute = ns_per_tick([&]() {
+				size_t hits = 0;
+				for (size_t i = 0; i < shots; i++) {
+					for (size_t j = 0; j < destructibles; j++) {
+						if (overlap(s.position[i], s.radius[i], d.position[j], d.radius[j])) {
+							hits++;
+							break;
+						}
+					}
+				}
+				sink = sink + hits;
+			});
+
+			double gridded = ns_per_tick([&]() {
+				grid.Clear();
+				for (size_t j = 0; j < destructibles; j++) {
+					grid.Insert(uint32_t(j), d.position[j], d.radius[j]);
+				}
+				grid.Build();
+				size_t hits = 0;
+				for (size_t i = 0; i < shots; i++) {
+					hits += grid.Query(s.position[i], s.radius[i], [&](uint32_t j) {
+						return overlap(s.position[i], s.radius[i], d.position[j], d.radius[j]);
+					});
+				}
+				sink = sink + hits;
+			});
+
+			if (crossover == 0 and gridded < brute) crossover = destructibles;
+			std::printf("%zu,%zu,%.1f,%.1f\n", shots, destructibles, brute, gridded);
+		}
+		if (crossover != 0) {
+			std::fprintf(stderr, "%zu shots: grid wins from %zu destructibles\n", shots, crossover);
+		}
+		else {
+			std::fprintf(stderr, "%zu shots: grid never wins in this sweep\n", shots);
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,139 @@
+#include "raylib.h"
+#include "raymath.h"
+
+#include <string>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <functional>
+#include <cstdio>
+#include <cstdint>
+
+#include "config.h"
+#include "command_line.h"
+#include "game.h"
+
+// Game::Update phases at scaled live bullet counts.
+//
+//   borno_bench [--quick] [--ticks N]
+//
+// Each scenario fills the enemy pool from one of the spawn functions in
+// spawn_fn.h, fired from emitters spread over the playing field, then times
+// N ticks. Output is CSV on stdout, one row per scenario and bullet count,
+// in ns per live bullet per tick for each phase, and the most frame arena
+// bytes any tick used.
+
+struct Scenario {
+	const char* name;
+	std::vector<SpawnFn> patterns;
+};
+
+constexpr int BENCH_DEFAULT_TICKS = 30;
+constexpr float BENCH_TICK = 1.0f / DEFAULT_SIMULATION_TICK_RATE;
+constexpr int BENCH_DESTRUCTIBLES = 32;
+constexpr float BENCH_MAX_AGE = 0.4f;
+
+static std::vector<Scenario> scenarios(void) {
+	return {
+		{ "linear_ring", { linear_ring(24, 1.0f, 0.0f) } },
+		{ "linear_spinny_ring", { linear_spinny_ring(12, 2.5f, 0.0f, 2.0f, 0.1f, PI) } },
+		{ "linear_aim_ring_pattern", { linear_aim_ring_pattern(10, 50.0f, 1.0f, 0.0f) } },
+		{ "single_aimed_shot", { single_aimed_shot(0.2f) } },
+		{ "mixed", {
+			linear_ring(24, 1.0f, 0.0f),
+			linear_spinny_ring(12, 2.5f, 0.0f, 2.0f, 0.1f, PI),
+			linear_aim_ring_pattern(10, 50.0f, 1.0f, 0.0f),
+			single_aimed_shot(0.2f)
+		} },
+	};
+}
+
+// fires every pattern once per emitter position until the pool holds count bullets,
+// ages are staggered so the bullets are spread out but still inside the killing field
+static void fill(Game& game, const Scenario& scenario, size_t count, std::mt19937& rng) {
+	std::uniform_real_distribution<float> x(PLAYING_FIELD_TOP_LEFT.x, PLAYING_FIELD_BOTTOM_RIGHT.x);
+	std::uniform_real_distribution<float> y(PLAYING_FIELD_TOP_LEFT.y, PLAYING_FIELD_BOTTOM_RIGHT.y);
+	std::uniform_real_distribution<float> age(0.0f, BENCH_MAX_AGE);
+	size_t pattern = 0;
+	while (game.enemy_projectiles.Size() < count) {
+		const SpawnFn& spawn_fn = scenario.patterns[pattern++ % scenario.patterns.size()];
+		auto push = [&](const ProjectileSpawner& ps) {
+			if (game.enemy_projectiles.Size() >= count) return;
+			Projectile projectile = ps.projectile_to_spawn;
+			projectile.delay = 0.0f;
+			projectile.et = age(rng);
+			game.enemy_projectiles.Push(projectile);
+		};
+		// a window wide enough to cross any cooldown boundary used above
+		spawn_fn(0.0f, 2.5f, Vector2{ x(rng), y(rng) }, game.player.position, SpawnSink::Into(push));
+	}
+
+	for (int i = 0; i < BENCH_DESTRUCTIBLES; i++) {
+		Destructible destructible{ POPCORN_RADIUS, BLUE, linear(Vector2{ x(rng), y(rng) }, Vector2Zero()), 1 << 30 };
+		game.AddDestructible(destructible);
+	}
+}
+
+struct PhaseTimes {
+	double update = 0.0;
+	double collision = 0.0;
+	double culling = 0.0;
+	double draw_prep = 0.0;
+};
+
+template <typename F>
+static double time_ns(F f) {
+	auto start = std::chrono::steady_clock::now();
+	f();
+	auto stop = std::chrono::steady_clock::now();
+	return double(std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count());
+}
+
+int main(int argc, char** argv) {
+	std::vector<size_t> counts = { 1000, 5000, 20000, 50000, 100000, 200000 };
+	int ticks = BENCH_DEFAULT_TICKS;
+	for (int i = 1; i < argc; i++) {
+		std::string option = argv[i];
+		if (option == "--quick") {
+			counts = { 1000, 20000 };
+		}
+		else if (option == "--ticks") {
+			if (i + 1 == argc or not parse_positive_int(argv[++i], ticks)) {
+				std::fprintf(stderr, "borno_bench: --ticks needs a positive whole number\n");
+				return 1;
+			}
+		}
+	}
+
+	PlayerInput input{ Vector2{ 1.0f, 0.0f }, false, true };
+
+	std::printf("scenario,bullets,ticks,isa,update_ns,collision_ns,culling_ns,draw_prep_ns,total_ns,arena_peak_tick_bytes\n");
+	for (const Scenario& scenario : scenarios()) {
+		for (size_t count : counts) {
+			std::mt19937 rng{ uint32_t(count) };
+			Game game(std::vector<DestructibleSpawner>{});
+			fill(game, scenario, count, rng);
+
+			PhaseTimes times;
+			double live = 0.0;
+			for (int t = 0; t < ticks; t++) {
+				live += double(game.enemy_projectiles.Size() + game.player_projectiles.Size());
+				game.frame_arena.Reset();
+				times.update += time_ns([&]() { game.Advance(BENCH_TICK, input); });
+				times.culling += time_ns([&]() { game.Cull(); });
+				times.collision += time_ns([&]() { game.Collide(); });
+				times.update += time_ns([&]() { game.UpdateDestructibles(BENCH_TICK); });
+				times.draw_prep += time_ns([&]() { game.PrepareDraw(0.5f, BENCH_TICK); });
+			}
+			game.frame_arena.Reset();
+
+			double per = live > 0.0 ? 1.0 / live : 0.0;
+			std::printf("%s,%zu,%d,%s,%.3f,%.3f,%.3f,%.3f,%.3f,%zu\n", scenario.name, count, ticks, TRAJECTORY_KERNEL_ISA,
+				times.update * per, times.collision * per, times.culling * per, times.draw_prep * per,
+				(times.update + times.collision + times.culling + times.draw_prep) * per, game.frame_arena.peak_frame_high_water);
+			std::fflush(stdout);
+		}
+	}
+
+	return 0;
+}
@@ -45,6 +45,16 @@
 *   #define RLGL_ENABLE_OPENGL_DEBUG_CONTEXT
 *       Enable debug context (only available on OpenGL 4.3)
 *
+*   #define RLGL_BATCH_BUFFER_ORPHANING
+*       Orphan render batch vertex buffers (glBufferData() with NULL) before every upload,
+*       so the driver hands out fresh storage instead of waiting on draws still reading it
+*
+*   #define RLGL_BATCH_VERTEX_2D
+*       Use a compact render batch vertex layout for 2D-only programs: XY positions without Z
+*       and texture coordinates as normalized 16-bit integers, 16 bytes per vertex instead of 24.
+*       Batch depth (currentDepth) is dropped and texcoords are clamped to [0..1],
+*       so 3D drawing and repeating texcoords through the batch are not supported
+*
 *   rlgl capabilities could be customized just defining some internal
 *   values before library inclusion (default values listed):
 *
@@ -192,13 +202,21 @@
     #if defined(GRAPHICS_API_OPENGL_11) || defined(GRAPHICS_API_OPENGL_33)
         // This is the maximum amount of elements (quads) per batch
         // NOTE: Be careful with text, every letter maps to a quad
-        #define RL_DEFAULT_BATCH_BUFFER_ELEMENTS  8192
+        #if defined(RLGL_BATCH_VERTEX_2D)
+            #define RL_DEFAULT_BATCH_BUFFER_ELEMENTS  12288     // Same memory as 8192 with the 3D vertex layout
+        #else
+            #define RL_DEFAULT_BATCH_BUFFER_ELEMENTS  8192
+        #endif
     #endif
     #if defined(GRAPHICS_API_OPENGL_ES2)
         // We reduce memory sizes for embedded systems (RPI and HTML5)
         // NOTE: On HTML5 (emscripten) this is allocated on heap,
         // by default it's only 16MB!...just take care...
-        #define RL_DEFAULT_BATCH_BUFFER_ELEMENTS  2048
+        #if defined(RLGL_BATCH_VERTEX_2D)
+            #define RL_DEFAULT_BATCH_BUFFER_ELEMENTS  3072      // Same memory as 2048 with the 3D vertex layout
+        #else
+            #define RL_DEFAULT_BATCH_BUFFER_ELEMENTS  2048
+        #endif
     #endif
 #endif
 #ifndef RL_DEFAULT_BATCH_BUFFERS
@@ -333,12 +351,24 @@ typedef struct Matrix {
 #define RL_MATRIX_TYPE
 #endif
 
+// Render batch vertex layout
+// NOTE: RL_BATCH_TEXCOORD() converts a float texcoord to the stored type
+#if defined(RLGL_BATCH_VERTEX_2D)
+    #define RL_BATCH_POSITION_COMPONENTS    2       // Vertex position components (XY)
+    #define RL_BATCH_TEXCOORD(x) ((rlBatchTexcoord)(((x) <= 0.0f)? 0 : ((x) >= 1.0f)? 65535 : (int)((x)*65535.0f + 0.5f)))
+    typedef unsigned short rlBatchTexcoord;         // Normalized 16-bit texture coordinate
+#else
+    #define RL_BATCH_POSITION_COMPONENTS    3       // Vertex position components (XYZ)
+    #define RL_BATCH_TEXCOORD(x) ((rlBatchTexcoord)(x))
+    typedef float rlBatchTexcoord;                  // Float texture coordinate
+#endif
+
 // Dynamic vertex buffers (position + texcoords + colors + indices arrays)
 typedef struct rlVertexBuffer {
     int elementCount;           // Number of elements in the buffer (QUADS)
 
-    float *vertices;            // Vertex position (XYZ - 3 components per vertex) (shader-location = 0)
-    float *texcoords;           // Vertex texture coordinates (UV - 2 components per vertex) (shader-location = 1)
+    float *vertices;            // Vertex position (RL_BATCH_POSITION_COMPONENTS per vertex) (shader-location = 0)
+    rlBatchTexcoord *texcoords; // Vertex texture coordinates (UV - 2 components per vertex) (shader-location = 1)
     unsigned char *colors;      // Vertex colors (RGBA - 4 components per vertex) (shader-location = 3)
 #if defined(GRAPHICS_API_OPENGL_11) || defined(GRAPHICS_API_OPENGL_33)
     unsigned int *indices;      // Vertex indices (in case vertex data comes indexed) (6 indices per quad)
@@ -377,6 +407,13 @@ typedef struct rlRenderBatch {
     float currentDepth;         // Current depth value for next draw
 } rlRenderBatch;
 
+// Render stats, accumulated until rlResetRenderStats()
+typedef struct rlRenderStats {
+    int batchDraws;             // Render batch draws that uploaded vertex data (flushes)
+    int vertexCount;            // Vertex uploaded by render batch draws
+    unsigned int uploadedBytes; // Bytes uploaded by render batch draws and rlUpdateVertexBuffer()
+} rlRenderStats;
+
 // OpenGL version
 typedef enum {
     RL_OPENGL_11 = 1,           // OpenGL 1.1
@@ -664,6 +701,9 @@ RLAPI void rlDrawRenderBatch(rlRenderBatch *batch);                         // D
 RLAPI void rlSetRenderBatchActive(rlRenderBatch *batch);                    // Set the active render batch for rlgl (NULL for default internal)
 RLAPI void rlDrawRenderBatchActive(void);                                   // Update and draw internal render batch
 RLAPI bool rlCheckRenderBatchLimit(int vCount);                             // Check internal buffer overflow for a given number of vertex
+RLAPI bool rlReserveVertices(int vCount, float **vertices, rlBatchTexcoord **texcoords, unsigned char **colors, float *depth); // Reserve vertex in current draw for direct writing, false if not possible
+RLAPI rlRenderStats rlGetRenderStats(void);                                 // Get render batch flushes and uploaded bytes since last reset
+RLAPI void rlResetRenderStats(void);                                        // Reset render stats, e.g. once per frame
 
 RLAPI void rlSetTexture(unsigned int id);               // Set current texture for render batch and check buffers limits
 
@@ -833,6 +873,15 @@ RLAPI void rlLoadDrawQuad(void);     // Load and draw a quad
     #define GL_SHADING_LANGUAGE_VERSION         0x8B8C
 #endif
 
+// Render batch texcoord attribute format
+#if defined(RLGL_BATCH_VERTEX_2D)
+    #define RL_BATCH_TEXCOORD_GL_TYPE           GL_UNSIGNED_SHORT
+    #define RL_BATCH_TEXCOORD_NORMALIZED        GL_TRUE
+#else
+    #define RL_BATCH_TEXCOORD_GL_TYPE           GL_FLOAT
+    #define RL_BATCH_TEXCOORD_NORMALIZED        GL_FALSE
+#endif
+
 #ifndef GL_COMPRESSED_RGB_S3TC_DXT1_EXT
     #define GL_COMPRESSED_RGB_S3TC_DXT1_EXT     0x83F0
 #endif
@@ -1013,6 +1062,8 @@ typedef struct rlglData {
         int maxDepthBits;                   // Maximum bits for depth component
 
     } ExtSupported;     // Extensions supported flags
+
+    rlRenderStats stats;                    // Render stats since last rlResetRenderStats()
 } rlglData;
 
 typedef void *(*rlglLoadProc)(const char *name);   // OpenGL extension functions loader signature (same as GLADloadproc)
@@ -1381,6 +1432,9 @@ void rlVertex3f(float x, float y, float z)
         ty = RLGL.State.transform.m1*x + RLGL.State.transform.m5*y + RLGL.State.transform.m9*z + RLGL.State.transform.m13;
         tz = RLGL.State.transform.m2*x + RLGL.State.transform.m6*y + RLGL.State.transform.m10*z + RLGL.State.transform.m14;
     }
+#if defined(RLGL_BATCH_VERTEX_2D)
+    (void)tz;   // Z is not stored by the 2D vertex layout
+#endif
 
     // WARNING: We can't break primitives when launching a new batch.
     // RL_LINES comes in pairs, RL_TRIANGLES come in groups of 3 vertices and RL_QUADS come in groups of 4 vertices.
@@ -1408,13 +1462,15 @@ void rlVertex3f(float x, float y, float z)
     }
 
     // Add vertices
-    RLGL.currentBatch->vertexBuffer[RLGL.currentBatch->currentBuffer].vertices[3*RLGL.State.vertexCounter] = tx;
-    RLGL.currentBatch->vertexBuffer[RLGL.currentBatch->currentBuffer].vertices[3*RLGL.State.vertexCounter + 1] = ty;
-    RLGL.currentBatch->vertexBuffer[RLGL.currentBatch->currentBuffer].vertices[3*RLGL.State.vertexCounter + 2] = tz;
+    RLGL.currentBatch->vertexBuffer[RLGL.currentBatch->currentBuffer].vertices[RL_BATCH_POSITION_COMPONENTS*RLGL.State.vertexCounter] = tx;
+    RLGL.currentBatch->vertexBuffer[RLGL.currentBatch->currentBuffer].vertices[RL_BATCH_POSITION_COMPONENTS*RLGL.State.vertexCounter + 1] = ty;
+#if !defined(RLGL_BATCH_VERTEX_2D)
+    RLGL.currentBatch->vertexBuffer[RLGL.currentBatch->currentBuffer].vertices[RL_BATCH_POSITION_COMPONENTS*RLGL.State.vertexCounter + 2] = tz;
+#endif
 
     // Add current texcoord
-    RLGL.currentBatch->vertexBuffer[RLGL.currentBatch->currentBuffer].texcoords[2*RLGL.State.vertexCounter] = RLGL.State.texcoordx;
-    RLGL.currentBatch->vertexBuffer[RLGL.currentBatch->currentBuffer].texcoords[2*RLGL.State.vertexCounter + 1] = RLGL.State.texcoordy;
+    RLGL.currentBatch->vertexBuffer[RLGL.currentBatch->currentBuffer].texcoords[2*RLGL.State.vertexCounter] = RL_BATCH_TEXCOORD(RLGL.State.texcoordx);
+    RLGL.currentBatch->vertexBuffer[RLGL.currentBatch->currentBuffer].texcoords[2*RLGL.State.vertexCounter + 1] = RL_BATCH_TEXCOORD(RLGL.State.texcoordy);
 
     // TODO: Add current normal
     // By default rlVertexBuffer type does not store normals
@@ -2486,8 +2542,8 @@ rlRenderBatch rlLoadRenderBatch(int numBuffers, int bufferElements)
     {
         batch.vertexBuffer[i].elementCount = bufferElements;
 
-        batch.vertexBuffer[i].vertices = (float *)RL_MALLOC(bufferElements*3*4*sizeof(float));        // 3 float by vertex, 4 vertex by quad
-        batch.vertexBuffer[i].texcoords = (float *)RL_MALLOC(bufferElements*2*4*sizeof(float));       // 2 float by texcoord, 4 texcoord by quad
+        batch.vertexBuffer[i].vertices = (float *)RL_MALLOC(bufferElements*RL_BATCH_POSITION_COMPONENTS*4*sizeof(float));   // 2 or 3 float by vertex, 4 vertex by quad
+        batch.vertexBuffer[i].texcoords = (rlBatchTexcoord *)RL_MALLOC(bufferElements*2*4*sizeof(rlBatchTexcoord));        // 2 components by texcoord, 4 texcoord by quad
         batch.vertexBuffer[i].colors = (unsigned char *)RL_MALLOC(bufferElements*4*4*sizeof(unsigned char));   // 4 float by color, 4 colors by quad
 #if defined(GRAPHICS_API_OPENGL_33)
         batch.vertexBuffer[i].indices = (unsigned int *)RL_MALLOC(bufferElements*6*sizeof(unsigned int));      // 6 int by quad (indices)
@@ -2496,8 +2552,8 @@ rlRenderBatch rlLoadRenderBatch(int numBuffers, int bufferElements)
         batch.vertexBuffer[i].indices = (unsigned short *)RL_MALLOC(bufferElements*6*sizeof(unsigned short));  // 6 int by quad (indices)
 #endif
 
-        for (int j = 0; j < (3*4*bufferElements); j++) batch.vertexBuffer[i].vertices[j] = 0.0f;
-        for (int j = 0; j < (2*4*bufferElements); j++) batch.vertexBuffer[i].texcoords[j] = 0.0f;
+        for (int j = 0; j < (RL_BATCH_POSITION_COMPONENTS*4*bufferElements); j++) batch.vertexBuffer[i].vertices[j] = 0.0f;
+        for (int j = 0; j < (2*4*bufferElements); j++) batch.vertexBuffer[i].texcoords[j] = 0;
         for (int j = 0; j < (4*4*bufferElements); j++) batch.vertexBuffer[i].colors[j] = 0;
 
         int k = 0;
@@ -2536,16 +2592,16 @@ rlRenderBatch rlLoadRenderBatch(int numBuffers, int bufferElements)
         // Vertex position buffer (shader-location = 0)
         glGenBuffers(1, &batch.vertexBuffer[i].vboId[0]);
         glBindBuffer(GL_ARRAY_BUFFER, batch.vertexBuffer[i].vboId[0]);
-        glBufferData(GL_ARRAY_BUFFER, bufferElements*3*4*sizeof(float), batch.vertexBuffer[i].vertices, GL_DYNAMIC_DRAW);
+        glBufferData(GL_ARRAY_BUFFER, bufferElements*RL_BATCH_POSITION_COMPONENTS*4*sizeof(float), batch.vertexBuffer[i].vertices, GL_DYNAMIC_DRAW);
         glEnableVertexAttribArray(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_POSITION]);
-        glVertexAttribPointer(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_POSITION], 3, GL_FLOAT, 0, 0, 0);
+        glVertexAttribPointer(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_POSITION], RL_BATCH_POSITION_COMPONENTS, GL_FLOAT, 0, 0, 0);
 
         // Vertex texcoord buffer (shader-location = 1)
         glGenBuffers(1, &batch.vertexBuffer[i].vboId[1]);
         glBindBuffer(GL_ARRAY_BUFFER, batch.vertexBuffer[i].vboId[1]);
-        glBufferData(GL_ARRAY_BUFFER, bufferElements*2*4*sizeof(float), batch.vertexBuffer[i].texcoords, GL_DYNAMIC_DRAW);
+        glBufferData(GL_ARRAY_BUFFER, bufferElements*2*4*sizeof(rlBatchTexcoord), batch.vertexBuffer[i].texcoords, GL_DYNAMIC_DRAW);
         glEnableVertexAttribArray(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_TEXCOORD01]);
-        glVertexAttribPointer(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_TEXCOORD01], 2, GL_FLOAT, 0, 0, 0);
+        glVertexAttribPointer(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_TEXCOORD01], 2, RL_BATCH_TEXCOORD_GL_TYPE, RL_BATCH_TEXCOORD_NORMALIZED, 0, 0);
 
         // Vertex color buffer (shader-location = 3)
         glGenBuffers(1, &batch.vertexBuffer[i].vboId[2]);
@@ -2654,18 +2710,32 @@ void rlDrawRenderBatch(rlRenderBatch *batch)
         // Activate elements VAO
         if (RLGL.ExtSupported.vao) glBindVertexArray(batch->vertexBuffer[batch->currentBuffer].vaoId);
 
+#if defined(RLGL_BATCH_BUFFER_ORPHANING)
+        int elementCount = batch->vertexBuffer[batch->currentBuffer].elementCount;
+#endif
+
         // Vertex positions buffer
         glBindBuffer(GL_ARRAY_BUFFER, batch->vertexBuffer[batch->currentBuffer].vboId[0]);
-        glBufferSubData(GL_ARRAY_BUFFER, 0, RLGL.State.vertexCounter*3*sizeof(float), batch->vertexBuffer[batch->currentBuffer].vertices);
+#if defined(RLGL_BATCH_BUFFER_ORPHANING)
+        // NOTE: Orphaning replaces the storage, so the upload does not wait on a previous draw still reading it
+        glBufferData(GL_ARRAY_BUFFER, elementCount*4*RL_BATCH_POSITION_COMPONENTS*sizeof(float), NULL, GL_DYNAMIC_DRAW);
+#endif
+        glBufferSubData(GL_ARRAY_BUFFER, 0, RLGL.State.vertexCounter*RL_BATCH_POSITION_COMPONENTS*sizeof(float), batch->vertexBuffer[batch->currentBuffer].vertices);
         //glBufferData(GL_ARRAY_BUFFER, sizeof(float)*3*4*batch->vertexBuffer[batch->currentBuffer].elementCount, batch->vertexBuffer[batch->currentBuffer].vertices, GL_DYNAMIC_DRAW);  // Update all buffer
 
         // Texture coordinates buffer
         glBindBuffer(GL_ARRAY_BUFFER, batch->vertexBuffer[batch->currentBuffer].vboId[1]);
-        glBufferSubData(GL_ARRAY_BUFFER, 0, RLGL.State.vertexCounter*2*sizeof(float), batch->vertexBuffer[batch->currentBuffer].texcoords);
+#if defined(RLGL_BATCH_BUFFER_ORPHANING)
+        glBufferData(GL_ARRAY_BUFFER, elementCount*4*2*sizeof(rlBatchTexcoord), NULL, GL_DYNAMIC_DRAW);
+#endif
+        glBufferSubData(GL_ARRAY_BUFFER, 0, RLGL.State.vertexCounter*2*sizeof(rlBatchTexcoord), batch->vertexBuffer[batch->currentBuffer].texcoords);
         //glBufferData(GL_ARRAY_BUFFER, sizeof(float)*2*4*batch->vertexBuffer[batch->currentBuffer].elementCount, batch->vertexBuffer[batch->currentBuffer].texcoords, GL_DYNAMIC_DRAW); // Update all buffer
 
         // Colors buffer
         glBindBuffer(GL_ARRAY_BUFFER, batch->vertexBuffer[batch->currentBuffer].vboId[2]);
+#if defined(RLGL_BATCH_BUFFER_ORPHANING)
+        glBufferData(GL_ARRAY_BUFFER, elementCount*4*4*sizeof(unsigned char), NULL, GL_DYNAMIC_DRAW);
+#endif
         glBufferSubData(GL_ARRAY_BUFFER, 0, RLGL.State.vertexCounter*4*sizeof(unsigned char), batch->vertexBuffer[batch->currentBuffer].colors);
         //glBufferData(GL_ARRAY_BUFFER, sizeof(float)*4*4*batch->vertexBuffer[batch->currentBuffer].elementCount, batch->vertexBuffer[batch->currentBuffer].colors, GL_DYNAMIC_DRAW);    // Update all buffer
 
@@ -2686,6 +2756,10 @@ void rlDrawRenderBatch(rlRenderBatch *batch)
 
         // Unbind the current VAO
         if (RLGL.ExtSupported.vao) glBindVertexArray(0);
+
+        RLGL.stats.batchDraws++;
+        RLGL.stats.vertexCount += RLGL.State.vertexCounter;
+        RLGL.stats.uploadedBytes += (unsigned int)(RLGL.State.vertexCounter*(RL_BATCH_POSITION_COMPONENTS*sizeof(float) + 2*sizeof(rlBatchTexcoord) + 4*sizeof(unsigned char)));
     }
     //------------------------------------------------------------------------------------------------------------
 
@@ -2731,12 +2805,12 @@ void rlDrawRenderBatch(rlRenderBatch *batch)
             {
                 // Bind vertex attrib: position (shader-location = 0)
                 glBindBuffer(GL_ARRAY_BUFFER, batch->vertexBuffer[batch->currentBuffer].vboId[0]);
-                glVertexAttribPointer(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_POSITION], 3, GL_FLOAT, 0, 0, 0);
+                glVertexAttribPointer(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_POSITION], RL_BATCH_POSITION_COMPONENTS, GL_FLOAT, 0, 0, 0);
                 glEnableVertexAttribArray(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_POSITION]);
 
                 // Bind vertex attrib: texcoord (shader-location = 1)
                 glBindBuffer(GL_ARRAY_BUFFER, batch->vertexBuffer[batch->currentBuffer].vboId[1]);
-                glVertexAttribPointer(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_TEXCOORD01], 2, GL_FLOAT, 0, 0, 0);
+                glVertexAttribPointer(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_TEXCOORD01], 2, RL_BATCH_TEXCOORD_GL_TYPE, RL_BATCH_TEXCOORD_NORMALIZED, 0, 0);
                 glEnableVertexAttribArray(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_TEXCOORD01]);
 
                 // Bind vertex attrib: color (shader-location = 3)
@@ -2885,6 +2959,56 @@ bool rlCheckRenderBatchLimit(int vCount)
     return overflow;
 }
 
+// Reserve vCount consecutive vertex in the current draw of the active batch and
+// get pointers to write them directly, skipping rlVertex3f() per vertex
+// NOTE: Batch is drawn first if they do not fit, caller must write whole primitives
+// of current draw mode, RL_BATCH_POSITION_COMPONENTS floats per vertex position (depth as z
+// unless RLGL_BATCH_VERTEX_2D) and texcoords through RL_BATCH_TEXCOORD(). Not possible with OpenGL 1.1
+// or while a transform matrix is pushed, those must go through rlVertex3f()
+bool rlReserveVertices(int vCount, float **vertices, rlBatchTexcoord **texcoords, unsigned char **colors, float *depth)
+{
+    bool reserved = false;
+
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+    if (!RLGL.State.transformRequired &&
+        (vCount < RLGL.currentBatch->vertexBuffer[RLGL.currentBatch->currentBuffer].elementCount*4))
+    {
+        rlCheckRenderBatchLimit(vCount);
+
+        rlVertexBuffer *buffer = &RLGL.currentBatch->vertexBuffer[RLGL.currentBatch->currentBuffer];
+        *vertices = buffer->vertices + RL_BATCH_POSITION_COMPONENTS*RLGL.State.vertexCounter;
+        *texcoords = buffer->texcoords + 2*RLGL.State.vertexCounter;
+        *colors = buffer->colors + 4*RLGL.State.vertexCounter;
+        *depth = RLGL.currentBatch->currentDepth;
+
+        RLGL.State.vertexCounter += vCount;
+        RLGL.currentBatch->draws[RLGL.currentBatch->drawCounter - 1].vertexCount += vCount;
+        reserved = true;
+    }
+#endif
+
+    return reserved;
+}
+
+// Get render stats accumulated since last rlResetRenderStats()
+rlRenderStats rlGetRenderStats(void)
+{
+    rlRenderStats stats = { 0 };
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+    stats = RLGL.stats;
+#endif
+    return stats;
+}
+
+// Reset render stats
+void rlResetRenderStats(void)
+{
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+    rlRenderStats stats = { 0 };
+    RLGL.stats = stats;
+#endif
+}
+
 // Textures data management
 //-----------------------------------------------------------------------------------------
 // Convert image data to OpenGL texture (returns OpenGL valid Id)
@@ -3556,6 +3680,7 @@ void rlUpdateVertexBuffer(unsigned int id, const void *data, int dataSize, int o
 #if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
     glBindBuffer(GL_ARRAY_BUFFER, id);
     glBufferSubData(GL_ARRAY_BUFFER, offset, dataSize, data);
+    RLGL.stats.uploadedBytes += (unsigned int)dataSize;
 #endif
 }
 
@@ -71,6 +71,15 @@
 #ifndef BEZIER_LINE_DIVISIONS
     #define BEZIER_LINE_DIVISIONS       24      // Bezier line divisions
 #endif
+#ifndef CIRCLE_TABLE_MIN_SEGMENTS
+    #define CIRCLE_TABLE_MIN_SEGMENTS    8      // Fewest segments used by DrawCirclesV()
+#endif
+#ifndef CIRCLE_TABLE_MAX_SEGMENTS
+    #define CIRCLE_TABLE_MAX_SEGMENTS   64      // Most segments used by DrawCirclesV(), even
+#endif
+#ifndef CIRCLE_TABLE_MAX_RADIUS
+    #define CIRCLE_TABLE_MAX_RADIUS    256      // Largest radius with a cached segment count, bigger ones use CIRCLE_TABLE_MAX_SEGMENTS
+#endif
 
 
 //----------------------------------------------------------------------------------
@@ -84,10 +93,17 @@
 Texture2D texShapes = { 1, 1, 1, 1, 7 };                // Texture used on shapes drawing (usually a white pixel)
 Rectangle texShapesRec = { 0.0f, 0.0f, 1.0f, 1.0f };    // Texture source rectangle used on shapes drawing
 
+// Unit circle points (sin, cos) for every even segment count, filled on first use
+static float circleTable[CIRCLE_TABLE_MAX_SEGMENTS/2 + 1][CIRCLE_TABLE_MAX_SEGMENTS + 1][2] = { 0 };
+static bool circleTableReady[CIRCLE_TABLE_MAX_SEGMENTS/2 + 1] = { 0 };
+static unsigned char circleSegments[CIRCLE_TABLE_MAX_RADIUS + 1] = { 0 };    // Segment count by radius rounded up, 0 until used
+
 //----------------------------------------------------------------------------------
 // Module specific Functions Declaration
 //----------------------------------------------------------------------------------
 static float EaseCubicInOut(float t, float b, float c, float d);    // Cubic easing
+static int GetCircleSegments(float radius);                         // Even segment count for a circle of that radius
+static const float (*GetCircleTable(int segments))[2];             // Unit circle points for an even segment count
 
 //----------------------------------------------------------------------------------
 // Module Functions Definition
@@ -511,6 +527,109 @@ void DrawCircleV(Vector2 center, float radius, Color color)
     DrawCircleSector(center, radius, 0, 360, 36, color);
 }
 
+// Draw many color-filled circles in one go
+// NOTE: Segment count follows each radius and points come from cached unit circle tables,
+// vertex are written straight into the render batch (see rlReserveVertices())
+void DrawCirclesV(const Vector2 *centers, const float *radii, const Color *colors, int count)
+{
+#if defined(SUPPORT_QUADS_DRAW_MODE)
+    const float texcoord[8] = {
+        texShapesRec.x/texShapes.width, texShapesRec.y/texShapes.height,
+        texShapesRec.x/texShapes.width, (texShapesRec.y + texShapesRec.height)/texShapes.height,
+        (texShapesRec.x + texShapesRec.width)/texShapes.width, (texShapesRec.y + texShapesRec.height)/texShapes.height,
+        (texShapesRec.x + texShapesRec.width)/texShapes.width, texShapesRec.y/texShapes.height
+    };
+    rlBatchTexcoord batchTexcoord[8] = { 0 };
+    for (int k = 0; k < 8; k++) batchTexcoord[k] = RL_BATCH_TEXCOORD(texcoord[k]);
+
+    rlSetTexture(texShapes.id);
+
+    rlBegin(RL_QUADS);
+#else
+    rlBegin(RL_TRIANGLES);
+#endif
+        for (int i = 0; i < count; i++)
+        {
+            Vector2 center = centers[i];
+            float radius = radii[i];
+            Color color = colors[i];
+            int segments = GetCircleSegments(radius);
+            const float (*table)[2] = GetCircleTable(segments);
+
+#if defined(SUPPORT_QUADS_DRAW_MODE)
+            // NOTE: Every QUAD represents two segments
+            int vertexCount = 2*segments;
+            const int step = 2;
+#else
+            int vertexCount = 3*segments;
+            const int step = 1;
+#endif
+            float *vertices = NULL;
+            rlBatchTexcoord *texcoords = NULL;
+            unsigned char *vertexColors = NULL;
+            float depth = 0.0f;
+
+            if (rlReserveVertices(vertexCount, &vertices, &texcoords, &vertexColors, &depth))
+            {
+                for (int s = 0; s < segments; s += step)
+                {
+                    // NOTE: Position is XY plus depth as Z unless the batch uses the 2D vertex layout
+                    vertices[0] = center.x;
+                    vertices[1] = center.y;
+#if !defined(RLGL_BATCH_VERTEX_2D)
+                    vertices[2] = depth;
+#endif
+                    for (int k = 1; k <= step + 1; k++)
+                    {
+                        vertices[RL_BATCH_POSITION_COMPONENTS*k] = center.x + table[s + k - 1][0]*radius;
+                        vertices[RL_BATCH_POSITION_COMPONENTS*k + 1] = center.y + table[s + k - 1][1]*radius;
+#if !defined(RLGL_BATCH_VERTEX_2D)
+                        vertices[RL_BATCH_POSITION_COMPONENTS*k + 2] = depth;
+#endif
+                    }
+                    vertices += RL_BATCH_POSITION_COMPONENTS*(step + 2);
+#if defined(SUPPORT_QUADS_DRAW_MODE)
+                    for (int k = 0; k < 8; k++) texcoords[k] = batchTexcoord[k];
+                    texcoords += 8;
+#endif
+                }
+
+                for (int k = 0; k < vertexCount; k++)
+                {
+                    vertexColors[4*k] = color.r;
+                    vertexColors[4*k + 1] = color.g;
+                    vertexColors[4*k + 2] = color.b;
+                    vertexColors[4*k + 3] = color.a;
+                }
+            }
+            else
+            {
+                // Same vertex one at a time, e.g. with a transform matrix pushed
+                rlColor4ub(color.r, color.g, color.b, color.a);
+
+                for (int s = 0; s < segments; s += step)
+                {
+#if defined(SUPPORT_QUADS_DRAW_MODE)
+                    rlTexCoord2f(texcoord[0], texcoord[1]);
+#endif
+                    rlVertex2f(center.x, center.y);
+                    for (int k = 0; k <= step; k++)
+                    {
+#if defined(SUPPORT_QUADS_DRAW_MODE)
+                        rlTexCoord2f(texcoord[2 + 2*k], texcoord[3 + 2*k]);
+#endif
+                        rlVertex2f(center.x + table[s + k][0]*radius, center.y + table[s + k][1]*radius);
+                    }
+                }
+            }
+        }
+    rlEnd();
+
+#if defined(SUPPORT_QUADS_DRAW_MODE)
+    rlSetTexture(0);
+#endif
+}
+
 // Draw circle outline
 void DrawCircleLines(int centerX, int centerY, float radius, Color color)
 {
@@ -1838,4 +1957,52 @@ static float EaseCubicInOut(float t, float b, float c, float d)
     return 0.5f*c*(t*t*t + 2.0f) + b;
 }
 
+// Get even segment count for a circle of that radius, cached by radius rounded up
+// NOTE: Same error rate rule as DrawCircleSector()
+static int GetCircleSegments(float radius)
+{
+    int r = (int)ceilf(radius);
+    if (r > CIRCLE_TABLE_MAX_RADIUS) return CIRCLE_TABLE_MAX_SEGMENTS;
+    if (r < 1) r = 1;
+
+    if (circleSegments[r] == 0)
+    {
+        int segments = CIRCLE_TABLE_MIN_SEGMENTS;
+
+        if (r > SMOOTH_CIRCLE_ERROR_RATE)
+        {
+            float th = acosf(2*powf(1 - SMOOTH_CIRCLE_ERROR_RATE/r, 2) - 1);
+            segments = (int)ceilf(2*PI/th);
+        }
+
+        segments += segments%2;
+        if (segments < CIRCLE_TABLE_MIN_SEGMENTS) segments = CIRCLE_TABLE_MIN_SEGMENTS;
+        if (segments > CIRCLE_TABLE_MAX_SEGMENTS) segments = CIRCLE_TABLE_MAX_SEGMENTS;
+
+        circleSegments[r] = (unsigned char)segments;
+    }
+
+    return circleSegments[r];
+}
+
+// Get unit circle points (sin, cos) for an even segment count, last point closes the circle
+static const float (*GetCircleTable(int segments))[2]
+{
+    float (*table)[2] = circleTable[segments/2];
+
+    if (!circleTableReady[segments/2])
+    {
+        for (int i = 0; i <= segments; i++)
+        {
+            float angle = 2*PI*(float)(i%segments)/(float)segments;
+            table[i][0] = sinf(angle);
+            table[i][1] = cosf(angle);
+        }
+
+        circleTableReady[segments/2] = true;
+    }
+
+    return (const float (*)[2])table;
+}
+
 #endif      // SUPPORT_MODULE_RSHAPES
@@ -0,0 +1,209 @@
+#include "raylib.h"
+#include "raymath.h"
+
+#include <string>
+#include <vector>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <cstdio>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+#include "config.h"
+#include "frame_clock.h"
+#include "game.h"
+#include "level.h"
+
+// Headless simulation: runs the level with scripted input as fast as the
+// machine allows, with no window, GL context or audio device.
+//
+//   borno_sim [--seconds S] [--tick-rate HZ] [--script FILE] [--check-allocations]
+//
+// A script has one "<time> <keys>" line per change of input, keys being any
+// of L R U D (direction), F (focus), Z (shoot) or - for none. Input holds
+// until the next line. Without a script the player strafes and shoots.
+//
+// --check-allocations runs a stationary emitter instead of the level, and
+// exits with status 1 if any tick after the warm-up allocates.
+
+constexpr float ALLOCATION_CHECK_WARMUP = 10.0f;
+constexpr double SIM_MAX_TICKS = 1e15;
+
+static uint64_t allocation_count = 0;
+
+void* operator new(std::size_t size) {
+	allocation_count++;
+	if (void* p = std::malloc(size > 0 ? size : 1)) return p;
+	throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+	std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+	std::free(p);
+}
+
+struct ScriptStep {
+	float time;
+	PlayerInput input;
+};
+
+static PlayerInput parse_keys(const std::string& keys) {
+	PlayerInput input;
+	Vector2 direction{ 0.0f, 0.0f };
+	for (char key : keys) {
+		switch (key) {
+		case 'L': direction.x -= 1.0f; break;
+		case 'R': direction.x += 1.0f; break;
+		case 'U': direction.y -= 1.0f; break;
+		case 'D': direction.y += 1.0f; break;
+		case 'F': input.focus = true; break;
+		case 'Z': input.shoot = true; break;
+		default: break;
+		}
+	}
+	input.direction = Vector2Normalize(direction);
+	return input;
+}
+
+static std::vector<ScriptStep> default_script(void) {
+	return {
+		{ 0.0f, parse_keys("LZ") },
+		{ 1.0f, parse_keys("RZ") },
+		{ 2.0f, parse_keys("LFZ") },
+		{ 3.0f, parse_keys("RFZ") },
+		{ 4.0f, parse_keys("UZ") },
+		{ 4.5f, parse_keys("DZ") },
+	};
+}
+
+static bool load_script(const char* path, std::vector<ScriptStep>& script) {
+	std::ifstream file(path);
+	if (not file) return false;
+	std::string line;
+	while (std::getline(file, line)) {
+		std::istringstream fields(line);
+		ScriptStep step;
+		std::string keys;
+		if (fields >> step.time >> keys) {
+			step.input = parse_keys(keys);
+			script.push_back(step);
+		}
+	}
+	return not script.empty();
+}
+
+// a destructible that never moves or dies, firing the heaviest test pattern
+static std::vector<DestructibleSpawner> allocation_check_level(void) {
+	std::vector<DestructibleSpawner> level;
+	level.push_back(DestructibleSpawner{
+		0.0f,
+		Destructible{
+			POPCORN_RADIUS,
+			BLUE,
+			linear(Vector2{ PLAYING_FIELD_RECT.x + PLAYING_FIELD_RECT.width * 0.5f, PLAYING_FIELD_RECT.y + PLAYING_FIELD_RECT.height * 0.25f }, Vector2Zero()),
+			1 << 30
+		},
+		linear_spinny_ring(12, 2.5f, 0.0f, 2.0f, 0.1f, PI)
+	});
+	return level;
+}
+
+int main(int argc, char** argv) {
+	float seconds = 60.0f;
+	float tick_rate = DEFAULT_SIMULATION_TICK_RATE;
+	std::vector<ScriptStep> script;
+	bool looping = false;
+
+	bool check_allocations = false;
+
+	for (int i = 1; i < argc; i++) {
+		std::string option = argv[i];
+		if (option == "--check-allocations") {
+			check_allocations = true;
+			continue;
+		}
+		if ((option == "--seconds" or option == "--tick-rate" or option == "--script") and i + 1 == argc) {
+			std::fprintf(stderr, "borno_sim: %s needs a value\n", option.c_str());
+			return 1;
+		}
+		if (option == "--seconds") {
+			if (not parse_positive_float(argv[++i], seconds)) {
+				std::fprintf(stderr, "borno_sim: --seconds %s is not a positive number\n", argv[i]);
+				return 1;
+			}
+		}
+		else if (option == "--tick-rate") {
+			if (not parse_tick_rate(argv[++i], tick_rate)) {
+				std::fprintf(stderr, "borno_sim: --tick-rate %s is not a positive number\n", argv[i]);
+				return 1;
+			}
+		}
+		else if (option == "--script") {
+			if (not load_script(argv[++i], script)) {
+				std::fprintf(stderr, "borno_sim: cannot read script %s\n", argv[i]);
+				return 1;
+			}
+		}
+	}
+	if (script.empty()) {
+		script = default_script();
+		looping = true;
+	}
+
+	// tick counts, warm-up included, have to fit the uint64_t they are converted to
+	if ((double(seconds) + double(ALLOCATION_CHECK_WARMUP)) * double(tick_rate) > SIM_MAX_TICKS) {
+		std::fprintf(stderr, "borno_sim: --seconds %g at %g Hz is too many ticks\n", double(seconds), double(tick_rate));
+		return 1;
+	}
+
+	float tick = 1.0f / tick_rate;
+	uint64_t total_ticks = uint64_t(seconds * tick_rate);
+	float script_length = script.back().time + 1.0f;
+
+	Game game(check_allocations ? allocation_check_level() : get_test_level());
+	uint64_t warmup_ticks = uint64_t(ALLOCATION_CHECK_WARMUP * tick_rate);
+	if (check_allocations) total_ticks += warmup_ticks;
+	uint64_t steady_allocations = 0;
+
+	size_t peak_enemy = 0, peak_player = 0;
+	size_t step = 0;
+	auto start = std::chrono::steady_clock::now();
+	for (uint64_t t = 0; t < total_ticks; t++) {
+		float now = float(t) * tick;
+		if (looping) now = fmodf(now, script_length);
+		if (now < script[step].time) step = 0;
+		while (step + 1 < script.size() and script[step + 1].time <= now) step++;
+
+		uint64_t allocations = allocation_count;
+		game.Update(tick, script[step].input);
+		if (t >= warmup_ticks) steady_allocations += allocation_count - allocations;
+
+		if (game.enemy_projectiles.Size() > peak_enemy) peak_enemy = game.enemy_projectiles.Size();
+		if (game.player_projectiles.Size() > peak_player) peak_player = game.player_projectiles.Size();
+	}
+	auto stop = std::chrono::steady_clock::now();
+
+	double wall = std::chrono::duration<double>(stop - start).count();
+	double simulated = double(total_ticks) / double(tick_rate);
+	std::printf("ticks %llu\n", (unsigned long long)total_ticks);
+	std::printf("simulated_seconds %.3f\n", simulated);
+	std::printf("wall_seconds %.3f\n", wall);
+	std::printf("speedup %.1f\n", wall > 0.0 ? simulated / wall : 0.0);
+	std::printf("peak_enemy_projectiles %zu\n", peak_enemy);
+	std::printf("peak_player_projectiles %zu\n", peak_player);
+	std::printf("destructibles %zu\n", game.destructibles.Size());
+	std::printf("culled_spawns %llu\n", (unsigned long long)game.culled_spawns);
+	// closes the last tick, Update only resets at the start of the next one
+	game.frame_arena.Reset();
+	std::printf("frame_arena_peak_tick_bytes %zu of %zu\n", game.frame_arena.peak_frame_high_water, game.frame_arena.buffer.size());
+	if (check_allocations) {
+		std::printf("steady_state_allocations %llu\n", (unsigned long long)steady_allocations);
+		return steady_allocations == 0 ? 0 : 1;
+	}
+	return 0;
+}
@@ -0,0 +1,318 @@
+#pragma once
+
+#include "raylib.h"
+#include "raymath.h"
+#include "rlgl.h"
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+#include "projectile_pool.h"
+
+// pixels of quad around each bullet for the antialiased edge, never more than the radius
+constexpr float BULLET_QUAD_PADDING = 1.0f;
+// distance field coordinates are stored as 0.5 + p * scale, with the padding capped
+// at the radius |p| stays within 2 and the texcoords within [0, 1], which the 2D
+// batch layout needs for its 16-bit texcoords
+constexpr float BULLET_SDF_TEXCOORD_SCALE = 0.25f;
+// bullets written per rlReserveVertices call, well under a batch buffer
+constexpr size_t BULLET_QUADS_PER_RESERVE = 256;
+// first size of each instance buffer, it doubles from there
+constexpr size_t BULLET_INSTANCE_CAPACITY = 1024;
+// instance buffers taken in turn, so an upload does not wait on a draw still reading the buffer
+constexpr size_t BULLET_INSTANCE_BUFFERS = 3;
+
+// unit quad as two triangles, rlDrawVertexArrayInstanced draws GL_TRIANGLES
+constexpr float BULLET_INSTANCE_QUAD[12] = {
+	-1.0f, -1.0f, -1.0f, 1.0f, 1.0f, 1.0f,
+	-1.0f, -1.0f, 1.0f, 1.0f, 1.0f, -1.0f,
+};
+
+// one per bullet in the streaming instance buffer
+struct BulletInstance {
+	Vector2 position;
+	float radius;
+	Color color;
+};
+
+static_assert(sizeof(BulletInstance) == 16, "instance records are uploaded as is");
+
+// Texcoords decode to p running from -k to k across the quad with the bullet edge
+// at length 1, the 4.0 undoes BULLET_SDF_TEXCOORD_SCALE. Coverage is the distance
+// to the edge in pixels through fwidth. Both versions sit on raylib's default
+// vertex shader, which passes fragTexCoord and fragColor.
+constexpr const char* BULLET_SDF_FS_330 = R"(#version 330
+in vec2 fragTexCoord;
+in vec4 fragColor;
+out vec4 finalColor;
+void main()
+{
+    float d = length((fragTexCoord - 0.5)*4.0);
+    float coverage = clamp((1.0 - d)/max(fwidth(d), 1e-5) + 0.5, 0.0, 1.0);
+    finalColor = vec4(fragColor.rgb, fragColor.a*coverage);
+}
+)";
+
+// Places the unit quad around each instance and hands the fragment shader the
+// same texcoords the SdfQuads path writes on the CPU.
+constexpr const char* BULLET_INSTANCE_VS_330 = R"(#version 330
+in vec2 vertexPosition;
+in vec3 instanceCircle;
+in vec4 instanceColor;
+uniform mat4 mvp;
+uniform float padding;
+out vec2 fragTexCoord;
+out vec4 fragColor;
+void main()
+{
+    float extent = instanceCircle.z + min(padding, instanceCircle.z);
+    fragTexCoord = 0.5 + vertexPosition*(instanceCircle.z > 0.0 ? extent/instanceCircle.z : 1.0)*0.25;
+    fragColor = instanceColor;
+    gl_Position = mvp*vec4(instanceCircle.xy + vertexPosition*extent, 0.0, 1.0);
+}
+)";
+
+constexpr const char* BULLET_SDF_FS_100 = R"(#version 100
+#extension GL_OES_standard_derivatives : enable
+precision mediump float;
+varying vec2 fragTexCoord;
+varying vec4 fragColor;
+void main()
+{
+    float d = length((fragTexCoord - 0.5)*4.0);
+    float coverage = clamp((1.0 - d)/max(fwidth(d), 1e-5) + 0.5, 0.0, 1.0);
+    gl_FragColor = vec4(fragColor.rgb, fragColor.a*coverage);
+}
+)";
+
+enum class BulletRenderMode : uint8_t {
+	// DrawCirclesV triangle fans
+	Circles,
+	// one quad per bullet, the circle is shaded from its distance field
+	SdfQuads,
+	// SdfQuads drawn with one instanced call per pool from one record per bullet
+	Instanced,
+};
+
+constexpr BulletRenderMode DEFAULT_BULLET_RENDER_MODE = BulletRenderMode::Instanced;
+
+inline bool parse_bullet_render_mode(const std::string& name, BulletRenderMode& mode) {
+	if (name == "circles") mode = BulletRenderMode::Circles;
+	else if (name == "sdf") mode = BulletRenderMode::SdfQuads;
+	else if (name == "instanced") mode = BulletRenderMode::Instanced;
+	else return false;
+	return true;
+}
+
+// Draws ProjectilePool::draw_position. A mode that can't be set up falls
+// back to the next simpler one, Instanced needs OpenGL 3.3 and SdfQuads 3.3
+// or ES2, anything else draws Circles.
+struct BulletRenderer {
+	BulletRenderMode mode = BulletRenderMode::Circles;
+	Shader sdf_shader{};
+
+	// a VAO over the shared quad and its own instance buffer
+	struct InstanceBuffer {
+		unsigned int vao = 0;
+		unsigned int vbo = 0;
+		size_t capacity = 0;
+	};
+
+	Shader instance_shader{};
+	int instance_mvp_loc = -1;
+	int instance_circle_loc = -1;
+	int instance_color_loc = -1;
+	unsigned int quad_vbo = 0;
+	InstanceBuffer instance_buffers[BULLET_INSTANCE_BUFFERS];
+	size_t next_instance_buffer = 0;
+	std::vector<BulletInstance> instances;
+
+	static inline bool Loaded(const Shader& shader) {
+		return shader.id != 0 and shader.id != rlGetShaderIdDefault();
+	}
+
+	// after InitWindow, mode is what actually got loaded
+	void Load(BulletRenderMode requested) {
+		int version = rlGetVersion();
+		bool glsl_330 = version == RL_OPENGL_33 or version == RL_OPENGL_43;
+		mode = requested;
+		if (mode == BulletRenderMode::Instanced and not (glsl_330 and LoadInstancing())) {
+			mode = BulletRenderMode::SdfQuads;
+		}
+		if (mode == BulletRenderMode::SdfQuads) {
+			const char* fs = glsl_330 ? BULLET_SDF_FS_330 : version == RL_OPENGL_ES_20 ? BULLET_SDF_FS_100 : nullptr;
+			if (fs != nullptr) sdf_shader = LoadShaderFromMemory(nullptr, fs);
+			if (not Loaded(sdf_shader)) mode = BulletRenderMode::Circles;
+		}
+	}
+
+	bool LoadInstancing(void) {
+		instance_shader = LoadShaderFromMemory(BULLET_INSTANCE_VS_330, BULLET_SDF_FS_330);
+		// a vertex shader that fails to build leaves the default one linked in, which has no instance inputs
+		bool loaded = Loaded(instance_shader);
+		int position_loc = loaded ? instance_shader.locs[SHADER_LOC_VERTEX_POSITION] : -1;
+		instance_circle_loc = loaded ? rlGetLocationAttrib(instance_shader.id, "instanceCircle") : -1;
+		instance_color_loc = loaded ? rlGetLocationAttrib(instance_shader.id, "instanceColor") : -1;
+		if (position_loc < 0 or instance_circle_loc < 0 or instance_color_loc < 0) {
+			UnloadInstancing();
+			return false;
+		}
+		instance_mvp_loc = rlGetLocationUniform(instance_shader.id, "mvp");
+		float padding = BULLET_QUAD_PADDING;
+		rlEnableShader(instance_shader.id);
+		rlSetUniform(rlGetLocationUniform(instance_shader.id, "padding"), &padding, RL_SHADER_UNIFORM_FLOAT, 1);
+		rlDisableShader();
+
+		quad_vbo = rlLoadVertexBuffer(BULLET_INSTANCE_QUAD, int(sizeof(BULLET_INSTANCE_QUAD)), false);
+		for (InstanceBuffer& buffer : instance_buffers) {
+			buffer.vao = rlLoadVertexArray();
+			if (buffer.vao == 0) {
+				UnloadInstancing();
+				return false;
+			}
+			rlEnableVertexArray(buffer.vao);
+			rlEnableVertexBuffer(quad_vbo);
+			rlSetVertexAttribute(unsigned(position_loc), 2, RL_FLOAT, false, 0, nullptr);
+			rlEnableVertexAttribute(unsigned(position_loc));
+			buffer.capacity = BULLET_INSTANCE_CAPACITY;
+			buffer.vbo = rlLoadVertexBuffer(nullptr, int(buffer.capacity * sizeof(BulletInstance)), true);
+			PointInstanceAttributes();
+			rlEnableVertexAttribute(unsigned(instance_circle_loc));
+			rlEnableVertexAttribute(unsigned(instance_color_loc));
+			rlSetVertexAttributeDivisor(unsigned(instance_circle_loc), 1);
+			rlSetVertexAttributeDivisor(unsigned(instance_color_loc), 1);
+			rlDisableVertexArray();
+		}
+		return true;
+	}
+
+	// with the buffer's VAO and VBO bound
+	void PointInstanceAttributes(void) {
+		rlSetVertexAttribute(unsigned(instance_circle_loc), 3, RL_FLOAT, false, int(sizeof(BulletInstance)), nullptr);
+		rlSetVertexAttribute(unsigned(instance_color_loc), 4, RL_UNSIGNED_BYTE, true, int(sizeof(BulletInstance)), (void*)offsetof(BulletInstance, color));
+	}
+
+	void UnloadInstancing(void) {
+		for (InstanceBuffer& buffer : instance_buffers) {
+			if (buffer.vao != 0) rlUnloadVertexArray(buffer.vao);
+			if (buffer.vbo != 0) rlUnloadVertexBuffer(buffer.vbo);
+			buffer = InstanceBuffer{};
+		}
+		if (quad_vbo != 0) rlUnloadVertexBuffer(quad_vbo);
+		if (Loaded(instance_shader)) UnloadShader(instance_shader);
+		instance_shader = Shader{};
+		quad_vbo = 0;
+	}
+
+	void Unload(void) {
+		UnloadInstancing();
+		if (Loaded(sdf_shader)) UnloadShader(sdf_shader);
+		sdf_shader = Shader{};
+		mode = BulletRenderMode::Circles;
+	}
+
+	void Draw(const ProjectilePool& pool) {
+		switch (mode) {
+		case BulletRenderMode::Circles:
+			pool.Draw();
+			break;
+		case BulletRenderMode::SdfQuads:
+			DrawSdfQuads(pool);
+			break;
+		case BulletRenderMode::Instanced:
+			DrawInstanced(pool);
+			break;
+		}
+	}
+
+	// an instance buffer is replaced by one twice the size when it runs out
+	void ReserveInstances(InstanceBuffer& buffer, size_t count) {
+		if (count <= buffer.capacity) return;
+		while (buffer.capacity < count) buffer.capacity *= 2;
+		rlEnableVertexArray(buffer.vao);
+		rlUnloadVertexBuffer(buffer.vbo);
+		buffer.vbo = rlLoadVertexBuffer(nullptr, int(buffer.capacity * sizeof(BulletInstance)), true);
+		PointInstanceAttributes();
+		rlDisableVertexArray();
+	}
+
+	void DrawInstanced(const ProjectilePool& pool) {
+		size_t count = pool.Size();
+		if (count == 0) return;
+		instances.resize(count);
+		for (size_t i = 0; i < count; i++) {
+			instances[i] = BulletInstance{ pool.draw_position[i], pool.radius[i], pool.color[i] };
+		}
+
+		// whatever is queued in the batch was drawn before these bullets
+		rlDrawRenderBatchActive();
+		InstanceBuffer& buffer = instance_buffers[next_instance_buffer];
+		next_instance_buffer = (next_instance_buffer + 1) % BULLET_INSTANCE_BUFFERS;
+		ReserveInstances(buffer, count);
+		rlUpdateVertexBuffer(buffer.vbo, instances.data(), int(count * sizeof(BulletInstance)), 0);
+
+		rlEnableShader(instance_shader.id);
+		Matrix mvp = MatrixMultiply(MatrixMultiply(rlGetMatrixTransform(), rlGetMatrixModelview()), rlGetMatrixProjection());
+		rlSetUniformMatrix(instance_mvp_loc, mvp);
+		rlEnableVertexArray(buffer.vao);
+		rlDrawVertexArrayInstanced(0, 6, int(count));
+		rlDisableVertexArray();
+		rlDisableShader();
+	}
+
+	void DrawSdfQuads(const ProjectilePool& pool) const {
+		const Vector2* position = pool.draw_position.data();
+		const float* radius = pool.radius.data();
+		const Color* color = pool.color.data();
+		size_t count = pool.Size();
+
+		// corners in the same order as DrawRectanglePro
+		const float corner[4][2] = { { -1.0f, -1.0f }, { -1.0f, 1.0f }, { 1.0f, 1.0f }, { 1.0f, -1.0f } };
+
+		BeginShaderMode(sdf_shader);
+		rlSetTexture(rlGetTextureIdDefault());
+		rlBegin(RL_QUADS);
+		for (size_t begin = 0; begin < count; begin += BULLET_QUADS_PER_RESERVE) {
+			size_t end = begin + BULLET_QUADS_PER_RESERVE < count ? begin + BULLET_QUADS_PER_RESERVE : count;
+			float* vertices;
+			rlBatchTexcoord* texcoords;
+			unsigned char* colors;
+			float depth;
+			bool direct = rlReserveVertices(int(4 * (end - begin)), &vertices, &texcoords, &colors, &depth);
+			for (size_t i = begin; i < end; i++) {
+				float half = radius[i] + fminf(BULLET_QUAD_PADDING, radius[i]);
+				float k = radius[i] > 0.0f ? half / radius[i] * BULLET_SDF_TEXCOORD_SCALE : BULLET_SDF_TEXCOORD_SCALE;
+				if (direct) {
+					for (int c = 0; c < 4; c++) {
+						vertices[0] = position[i].x + corner[c][0] * half;
+						vertices[1] = position[i].y + corner[c][1] * half;
+#if !defined(RLGL_BATCH_VERTEX_2D)
+						vertices[2] = depth;
+#endif
+						texcoords[0] = RL_BATCH_TEXCOORD(0.5f + corner[c][0] * k);
+						texcoords[1] = RL_BATCH_TEXCOORD(0.5f + corner[c][1] * k);
+						colors[0] = color[i].r;
+						colors[1] = color[i].g;
+						colors[2] = color[i].b;
+						colors[3] = color[i].a;
+						vertices += RL_BATCH_POSITION_COMPONENTS;
+						texcoords += 2;
+						colors += 4;
+					}
+				}
+				else {
+					rlColor4ub(color[i].r, color[i].g, color[i].b, color[i].a);
+					for (int c = 0; c < 4; c++) {
+						rlTexCoord2f(0.5f + corner[c][0] * k, 0.5f + corner[c][1] * k);
+						rlVertex2f(position[i].x + corner[c][0] * half, position[i].y + corner[c][1] * half);
+					}
+				}
+			}
+		}
+		rlEnd();
+		rlSetTexture(0);
+		EndShaderMode();
+	}
+};
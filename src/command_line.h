@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cmath>
+#include <cstdlib>
+#include <climits>
+
+// Numeric option values. The whole argument has to be the number, and
+// anything that is not finite and above zero is refused so the caller can
+// report it instead of running with a broken setting.
+
+inline bool parse_positive_float(const char* text, float& value) {
+	char* end = nullptr;
+	float parsed = std::strtof(text, &end);
+	if (end == text or *end != '\0' or not std::isfinite(parsed) or parsed <= 0.0f) return false;
+	value = parsed;
+	return true;
+}
+
+inline bool parse_positive_int(const char* text, int& value) {
+	char* end = nullptr;
+	long parsed = std::strtol(text, &end, 10);
+	if (end == text or *end != '\0' or parsed <= 0 or parsed > INT_MAX) return false;
+	value = int(parsed);
+	return true;
+}
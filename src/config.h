@@ -61,4 +61,17 @@ constexpr float PLAYER_FOCUS_SPEED = 0.5f * PLAYER_NORMAL_SPEED;
 
 constexpr float PLAYER_SHOOT_CD = 0.04f;
 
+constexpr bool PLAYER_SHOT_CANCELS_ENEMY_SHOT = true;
+
 constexpr float FAST_FORWARD_THRESHOLD = 1.f;
+
+constexpr float DEFAULT_SIMULATION_TICK_RATE = 120.f;
+
+constexpr int BROADPHASE_CELL_HORIZONTAL_TILES = 2;
+constexpr int BROADPHASE_CELL_VERTICAL_TILES = 2;
+
+
+constexpr int PLAYER_PROJECTILE_CAPACITY = 256;
+constexpr int ENEMY_PROJECTILE_CAPACITY = 4096;
+
+constexpr size_t FRAME_ARENA_BYTES = 64 * 1024;
\ No newline at end of file
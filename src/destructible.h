@@ -3,9 +3,12 @@
 #include "raylib.h"
 #include "raymath.h"
 
-#include <memory>
+#include <vector>
+#include <algorithm>
+#include <utility>
 
 #include "emitter.h"
+#include "slot_map.h"
 
 constexpr float TESTING_DUMMY_RADIUS = 20.f;
 constexpr int TESTING_DUMMY_HEALTH = 10;
@@ -18,17 +21,40 @@ constexpr int POPCORN_HEALTH = 2;
 struct Destructible {
 	float radius;
 	Color color;
-	std::function<Vector2(float)> interpolate;
+	Trajectory trajectory;
 
 	int health;
-	std::shared_ptr<Emitter> contained_emitter = nullptr;
+	// the emitter this destructible carries, if any, owned by Game::emitters
+	SlotHandle emitter{};
+	// root node in Game::transforms, follows position and carries the emitter
+	SlotHandle transform{};
 
 	float et = 0.0f;
+	Vector2 position{};
+	Vector2 previous_position{};
+	// solved once in Start for the kinds that allow it
+	bool has_exit_time = false;
+	float exit_time = 0.0f;
+
+	inline void Place(void) {
+		position = interpolate(trajectory, et);
+	}
+
+	// puts the destructible at the start of its path
+	inline void Start(void) {
+		Place();
+		previous_position = position;
+		has_exit_time = killing_field_exit_time(trajectory, exit_time);
+	}
 
 	bool Update(float delta) {
+		previous_position = position;
 		et += delta;
-		Vector2 position = interpolate(et);
-		if (contained_emitter != nullptr) { contained_emitter->position = position; }
+		Place();
+
+		if (has_exit_time) {
+			return et >= exit_time;
+		}
 
 		if (position.x < KILLING_FIELD_TOP_LEFT.x or
 			position.x > KILLING_FIELD_BOTTOM_RIGHT.x or
@@ -40,29 +66,38 @@ struct Destructible {
 		return false;
 	}
 
-	void Draw(void) {
-		DrawCircleV(interpolate(et), radius, color);
+	void Draw(float alpha) {
+		DrawCircleV(Vector2Lerp(previous_position, position, alpha), radius, color);
 	}
 
 	inline bool Hurt(void) {
 		return --health <= 0;
 	}
 
-	inline Vector2 GetPosition() {
-		return interpolate(et);
+	inline Vector2 GetPosition() const {
+		return position;
 	}
 };
 
 struct DestructibleSpawner {
-	float cd_timer;
+	// seconds since the level started
+	float time;
 	Destructible destructible_to_spawn;
-	bool Update(float delta) {
-		if (cd_timer <= 0.0f) {
-			return true;
-		}
-		if (cd_timer > 0.0f) {
-			cd_timer -= delta;
-		}
-		return false;
+	// an emitter is created for the destructible when it spawns, unless this is empty
+	SpawnFn emitter_spawn_fn = nullptr;
+	// where the emitter sits relative to the destructible
+	Vector2 emitter_offset{};
+};
+
+// Level spawns in time order. Game keeps a cursor to the first one not yet
+// released and releases every spawn due in a tick together.
+struct SpawnTimeline {
+	std::vector<DestructibleSpawner> spawners;
+	size_t next = 0;
+
+	SpawnTimeline(std::vector<DestructibleSpawner> level_spawners = {}) : spawners(std::move(level_spawners)) {
+		std::stable_sort(spawners.begin(), spawners.end(), [](const DestructibleSpawner& l, const DestructibleSpawner& r) {
+			return l.time < r.time;
+		});
 	}
 };
\ No newline at end of file
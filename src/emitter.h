@@ -3,41 +3,75 @@
 #include "raylib.h"
 #include "raymath.h"
 
-#include <queue>
-#include <memory>
+#include <functional>
+#include <type_traits>
+#include <cstdint>
 
 #include "projectile.h"
+#include "slot_map.h"
 
 constexpr float TESTING_EMITTER_SHOT_CD = 1.0f;
+// spawn times that land this close past a tick boundary, in ticks, count as on it
+constexpr float EMITTER_TICK_EPSILON = 1e-3f;
 
 struct ProjectileSpawner {
 	float time_to_spawn;
 	Projectile projectile_to_spawn;
 };
 
-struct PSCompare {
-	bool operator() (ProjectileSpawner& ls, ProjectileSpawner& rs) {
-		return ls.time_to_spawn > rs.time_to_spawn;
-	};
+// Non-owning output of a spawn function. It points at whatever storage the
+// caller provides, so spawning never builds a container of its own.
+struct SpawnSink {
+	void* target;
+	void (*write)(void* target, const ProjectileSpawner& spawner);
+
+	template <typename F>
+	static inline SpawnSink Into(F& f) {
+		return SpawnSink{ &f, [](void* target, const ProjectileSpawner& spawner) { (*static_cast<F*>(target))(spawner); } };
+	}
+
+	inline void operator()(const ProjectileSpawner& spawner) const {
+		write(target, spawner);
+	}
+};
+
+// et, dt, emitter position, player position, sink for the shots fired in (et, et + dt],
+// returns the earliest time after et + dt at which the pattern can fire again
+using SpawnFn = std::function<float(float, float, Vector2, Vector2, SpawnSink)>;
+
+// a future shot and the emitter that fired it, dropped if the emitter is gone by then
+struct ScheduledShot {
+	SlotHandle emitter;
+	Projectile projectile;
 };
 
+static_assert(std::is_trivially_copyable<ScheduledShot>::value, "scheduled shots are copied by value");
+
+// Emitters only run on ticks where their pattern can fire, Game keeps them
+// asleep on a timer wheel in between. Times are local to the emitter, local
+// tick k covers (k * delta, (k + 1) * delta]. Where the emitter is comes from
+// its node in Game::transforms.
 struct Emitter {
-	std::function<std::vector<ProjectileSpawner>(float, float, Vector2, Vector2)> spawn_fn;
-	std::list<std::shared_ptr<Emitter>>::iterator it;
-	Vector2 position;
-	std::priority_queue<ProjectileSpawner, std::vector<ProjectileSpawner>, PSCompare> ps_queue;
-	float et = 0.0f;
-	std::vector<Projectile> Update(float delta, Vector2 player_pos) {
-		std::vector<ProjectileSpawner> nps = spawn_fn(et, delta, position, player_pos);
-		for (ProjectileSpawner ps : nps) {
-			ps_queue.push(ps);
-		}
-		std::vector<Projectile> pts;
-		et += delta;
-		while (not ps_queue.empty() and ps_queue.top().time_to_spawn <= et) {
-			pts.push_back(ps_queue.top().projectile_to_spawn);
-			ps_queue.pop();
-		}
-		return pts;
+	SpawnFn spawn_fn;
+	SlotHandle transform;
+	// game tick of local tick 0
+	uint32_t start_tick = 0;
+	// spawn_fn has been asked about every time up to here
+	float covered = 0.0f;
+
+	// asks spawn_fn about everything since the last call up to the end of local tick k,
+	// returns the local tick to wake up on next
+	uint32_t Fire(uint32_t k, float delta, Vector2 position, Vector2 player_pos, SpawnSink sink) {
+		float end = float(k + 1) * delta;
+		float next = spawn_fn(covered, end - covered, position, player_pos, sink);
+		covered = end;
+		uint32_t wake = LocalTick(next, delta);
+		return wake > k ? wake : k + 1;
 	}
-};
\ No newline at end of file
+
+	// the local tick that covers time
+	static inline uint32_t LocalTick(float time, float delta) {
+		float k = delta > 0.0f ? ceilf(time / delta - EMITTER_TICK_EPSILON) - 1.0f : 0.0f;
+		return k > 0.0f ? uint32_t(k) : 0u;
+	}
+};
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+#include "config.h"
+
+// Bump allocator for scratch containers that live for one tick. Reset at the
+// start of every tick releases everything at once. Requests that do not fit
+// fall back to malloc and are freed on the next Reset, they still count
+// towards the high-water marks so they show how large the arena should be.
+struct FrameArena {
+	std::vector<unsigned char> buffer;
+	std::vector<void*> overflow;
+	size_t offset = 0;
+	size_t overflow_bytes = 0;
+	// bytes the last finished tick used, and the most any tick has used
+	size_t frame_high_water = 0;
+	size_t peak_frame_high_water = 0;
+
+	explicit FrameArena(size_t capacity = FRAME_ARENA_BYTES) : buffer(capacity) {
+		overflow.reserve(16);
+	}
+
+	FrameArena(const FrameArena&) = delete;
+	FrameArena& operator=(const FrameArena&) = delete;
+
+	~FrameArena() {
+		Reset();
+	}
+
+	inline size_t Used(void) const {
+		return offset + overflow_bytes;
+	}
+
+	// closes the tick that just ended, nothing is freed during a tick so Used() is its peak
+	void Reset(void) {
+		frame_high_water = Used();
+		if (frame_high_water > peak_frame_high_water) peak_frame_high_water = frame_high_water;
+		for (void* p : overflow) std::free(p);
+		overflow.clear();
+		offset = 0;
+		overflow_bytes = 0;
+	}
+
+	void* Allocate(size_t size, size_t alignment) {
+		uintptr_t base = uintptr_t(buffer.data());
+		size_t start = size_t((base + offset + alignment - 1) / alignment * alignment - base);
+		void* p;
+		if (start + size <= buffer.size()) {
+			offset = start + size;
+			p = buffer.data() + start;
+		}
+		else {
+			p = std::malloc(size > 0 ? size : 1);
+			if (p == nullptr) throw std::bad_alloc();
+			overflow.push_back(p);
+			overflow_bytes += size;
+		}
+		return p;
+	}
+};
+
+// std allocator adaptor over a FrameArena, deallocate is a no-op
+template <typename T>
+struct ArenaAllocator {
+	using value_type = T;
+
+	FrameArena* arena;
+
+	explicit ArenaAllocator(FrameArena& frame_arena) : arena(&frame_arena) {}
+
+	template <typename U>
+	ArenaAllocator(const ArenaAllocator<U>& other) : arena(other.arena) {}
+
+	inline T* allocate(size_t n) {
+		return static_cast<T*>(arena->Allocate(n * sizeof(T), alignof(T)));
+	}
+
+	inline void deallocate(T*, size_t) {}
+
+	template <typename U>
+	inline bool operator==(const ArenaAllocator<U>& other) const {
+		return arena == other.arena;
+	}
+
+	template <typename U>
+	inline bool operator!=(const ArenaAllocator<U>& other) const {
+		return arena != other.arena;
+	}
+};
+
+template <typename T>
+using FrameVector = std::vector<T, ArenaAllocator<T>>;
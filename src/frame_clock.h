@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+
+#include "config.h"
+#include "command_line.h"
+
+// Turns variable frame times into a number of fixed simulation ticks.
+// A frame longer than FAST_FORWARD_THRESHOLD (window drag, audio hiccup)
+// is a stall: only FAST_FORWARD_THRESHOLD of it is caught up, still in
+// fixed ticks so nothing tunnels, and the rest of the stall is dropped.
+struct FrameClock {
+	float tick;
+	float accumulator = 0.0f;
+
+	// ticks run back to back without a frame drawn in between
+	uint64_t merged_ticks = 0;
+	// ticks thrown away because a stall went past FAST_FORWARD_THRESHOLD
+	uint64_t dropped_ticks = 0;
+
+	explicit FrameClock(float tick_rate) : tick(1.0f / tick_rate) {}
+
+	// returns how many ticks to simulate before drawing this frame
+	int Advance(float frame_delta) {
+		if (frame_delta > FAST_FORWARD_THRESHOLD) {
+			dropped_ticks += uint64_t((frame_delta - FAST_FORWARD_THRESHOLD) / tick);
+			frame_delta = FAST_FORWARD_THRESHOLD;
+		}
+
+		accumulator += frame_delta;
+		int ticks = int(accumulator / tick);
+		accumulator -= float(ticks) * tick;
+		if (ticks > 1) {
+			merged_ticks += uint64_t(ticks - 1);
+		}
+		return ticks;
+	}
+
+	// how far between the last two ticks the frame is drawn
+	inline float Alpha(void) const {
+		return accumulator / tick;
+	}
+};
+
+// a finite, positive rate in Hz, false for anything else so the caller can keep its default
+inline bool parse_tick_rate(const char* text, float& tick_rate) {
+	return parse_positive_float(text, tick_rate);
+}
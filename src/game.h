@@ -0,0 +1,289 @@
+#pragma once
+
+#include "raylib.h"
+#include "raymath.h"
+
+#include <vector>
+#include <functional>
+
+#include "config.h"
+
+#include "emitter.h"
+#include "destructible.h"
+#include "frame_arena.h"
+#include "slot_map.h"
+#include "timer_wheel.h"
+#include "transform.h"
+#include "projectile.h"
+#include "projectile_pool.h"
+#include "spatial_grid.h"
+#include "sweep_and_prune.h"
+
+#include "interpolate_fn.h"
+#include "spawn_fn.h"
+
+constexpr float BASIC_PLAYER_SHOT_RADIUS = 8.0f;
+constexpr float BASIC_PLAYER_SHOT_SPEED = 800.0f;
+
+constexpr float SPLIT_PLAYER_SHOT_RADIUS = 8.0f;
+constexpr float SPLIT_PLAYER_SHOT_H_SPEED = 600.0f;
+constexpr float SPLIT_PLAYER_SHOT_V_SPEED = 600.0f;
+
+inline void fire_basic_player_shot(Vector2 position, ProjectilePool& shots) {
+	shots.Push(Projectile{ BASIC_PLAYER_SHOT_RADIUS, RED, linear(position, Vector2{ 0.0f, -BASIC_PLAYER_SHOT_SPEED })});
+}
+
+inline void fire_split_player_shot(Vector2 position, ProjectilePool& shots) {
+	shots.Push(Projectile{ SPLIT_PLAYER_SHOT_RADIUS, RED, horizontal_bounce(position, Vector2{ -SPLIT_PLAYER_SHOT_H_SPEED, -SPLIT_PLAYER_SHOT_V_SPEED })});
+	shots.Push(Projectile{ SPLIT_PLAYER_SHOT_RADIUS, RED, horizontal_bounce(position, Vector2{ SPLIT_PLAYER_SHOT_H_SPEED, -SPLIT_PLAYER_SHOT_V_SPEED })});
+}
+
+inline Destructible get_popcorn_0(Vector2 position, Vector2 direction) {
+	return Destructible{ POPCORN_RADIUS, BLUE, linear(position, Vector2Scale(Vector2Normalize(direction), POPCORN_SPEED)), POPCORN_HEALTH };
+}
+
+inline Destructible get_popcorn_1(Vector2 from, Vector2 to, Vector2 control, float travel_time) {
+	return Destructible{ POPCORN_RADIUS, BLUE, quadratic_bezier(from, to, control, travel_time), POPCORN_HEALTH };
+}
+
+struct PlayerInput {
+	Vector2 direction{ 0.0f, 0.0f };
+	bool focus = false;
+	bool shoot = false;
+};
+
+struct Player {
+	Vector2 position;
+	Vector2 velocity{ 0.0f, 0.0f };
+	Vector2 previous_position;
+
+	float shoot_timer = 0.0f;
+
+	// new shots are pushed straight into shots
+	void Update(float delta, const PlayerInput& input, ProjectilePool& shots) {
+		bool is_focus = input.focus;
+
+		previous_position = position;
+		velocity = Vector2Scale(input.direction, is_focus ? PLAYER_FOCUS_SPEED : PLAYER_NORMAL_SPEED);
+		position = Vector2Add(position, Vector2Scale(velocity, delta));
+		position = Vector2Clamp(position, PLAYING_FIELD_TOP_LEFT, PLAYING_FIELD_BOTTOM_RIGHT);
+
+		if (input.shoot and shoot_timer <= 0.0f) {
+			shoot_timer = PLAYER_SHOOT_CD;
+			if (is_focus) {
+				fire_split_player_shot(position, shots);
+			}
+			else {
+				fire_basic_player_shot(position, shots);
+			}
+		}
+		else if (shoot_timer > 0.0f) {
+			shoot_timer -= delta;
+		}
+	}
+
+	void Draw(float alpha) {
+		DrawCircleV(Vector2Lerp(previous_position, position, alpha), PLAYER_HITBOX_RADIUS, PINK);
+	}
+};
+
+struct Game {
+	Player player{};
+	SpawnTimeline timeline;
+	ProjectilePool player_projectiles;
+	ProjectilePool enemy_projectiles;
+	SlotMap<Destructible> destructibles;
+	SlotMap<Emitter> emitters;
+	// destructibles are roots, emitters hang off them, resolved at the end of every tick
+	TransformSystem transforms;
+	// counts Advance calls
+	uint32_t tick = 0;
+	// sleeping emitters by the tick they wake on
+	TimerWheel<SlotHandle> wakeups;
+	TimerWheel<ScheduledShot> shot_schedule;
+	// enemy shots dropped at spawn because they could never be seen
+	uint64_t culled_spawns = 0;
+	SpatialGrid<Destructible*> destructible_grid;
+	SweepAndPrune shot_sweep;
+	FrameArena frame_arena;
+
+	Game(std::vector<DestructibleSpawner> level_spawners) : timeline(std::move(level_spawners)) {
+		player.position = PLAYER_INITIAL_VECTOR;
+		player.previous_position = PLAYER_INITIAL_VECTOR;
+		player_projectiles.Reserve(PLAYER_PROJECTILE_CAPACITY);
+		enemy_projectiles.Reserve(ENEMY_PROJECTILE_CAPACITY);
+		shot_sweep.Reserve(PLAYER_PROJECTILE_CAPACITY, ENEMY_PROJECTILE_CAPACITY);
+	}
+
+	void Dead(void) {
+		
+	}
+
+	void Update(float delta, const PlayerInput& input) {
+		frame_arena.Reset();
+		SpawnDestructibles(delta);
+		Advance(delta, input);
+		Cull();
+		Collide();
+		UpdateDestructibles(delta);
+	}
+
+	void SpawnDestructibles(float delta) {
+		// everything due this tick arrives together, the stores grow once per batch
+		size_t begin = timeline.next;
+		size_t end = begin;
+		while (end < timeline.spawners.size() and TicksFor(timeline.spawners[end].time, delta) <= tick) end++;
+		if (end != begin) {
+			destructibles.ReserveMore(end - begin);
+			emitters.ReserveMore(end - begin);
+		}
+		for (size_t i = begin; i < end; i++) {
+			const DestructibleSpawner& spawner = timeline.spawners[i];
+			AddDestructible(spawner.destructible_to_spawn, spawner.emitter_spawn_fn, spawner.emitter_offset);
+		}
+		timeline.next = end;
+	}
+
+	// starts the destructible on a root transform and attaches an emitter to it unless emitter_spawn_fn is empty
+	SlotHandle AddDestructible(Destructible destructible, const SpawnFn& emitter_spawn_fn = nullptr, Vector2 emitter_offset = Vector2Zero()) {
+		destructible.Start();
+		destructible.transform = transforms.Create(destructible.position);
+		if (emitter_spawn_fn) {
+			destructible.emitter = AttachEmitter(destructible.transform, emitter_spawn_fn, emitter_offset);
+		}
+		return destructibles.Insert(destructible);
+	}
+
+	// An emitter on its own node at offset from parent, e.g. a turret on a boss
+	// part. It first fires on the current tick. Once the node is gone, which
+	// happens on the Resolve after any of its ancestors is destroyed, its
+	// scheduled shots are dropped and the emitter is removed.
+	SlotHandle AttachEmitter(SlotHandle parent, const SpawnFn& spawn_fn, Vector2 offset) {
+		SlotHandle handle = emitters.Insert(Emitter{ spawn_fn, transforms.Create(offset, parent), tick });
+		wakeups.Insert(tick, handle);
+		return handle;
+	}
+
+	// first tick at or after seconds
+	static inline uint32_t TicksFor(float seconds, float delta) {
+		float ticks = delta > 0.0f ? ceilf(seconds / delta - EMITTER_TICK_EPSILON) : 0.0f;
+		return ticks > 0.0f ? uint32_t(ticks) : 0u;
+	}
+
+	// removes the destructible at dense index i together with the emitter it carries,
+	// anything else attached to its transform goes on the next Resolve
+	void RemoveDestructible(size_t i) {
+		emitters.Remove(destructibles.values[i].emitter);
+		transforms.Destroy(destructibles.values[i].transform);
+		destructibles.RemoveAt(i);
+	}
+
+	// moves every bullet and the player, and releases new shots
+	void Advance(float delta, const PlayerInput& input) {
+		player_projectiles.Update(delta);
+		player.Update(delta, input, player_projectiles);
+		// popped before any fires, a wakeup an emitter schedules is always for a later tick
+		FrameVector<SlotHandle> due_emitters{ ArenaAllocator<SlotHandle>(frame_arena) };
+		wakeups.PopDue(tick, [&](SlotHandle handle) {
+			due_emitters.push_back(handle);
+		});
+		for (SlotHandle handle : due_emitters) {
+			// removed while it was asleep
+			Emitter* emitter = emitters.Get(handle);
+			if (emitter == nullptr) continue;
+			if (not transforms.Contains(emitter->transform)) {
+				emitters.Remove(handle);
+				continue;
+			}
+			auto schedule_shot = [&](const ProjectileSpawner& ps) {
+				if (not may_enter_playing_field(ps.projectile_to_spawn.trajectory, ps.projectile_to_spawn.radius)) {
+					culled_spawns++;
+					return;
+				}
+				// the shot is released at the start of the tick covering its spawn time,
+				// the part of that tick before the spawn time is added to its delay
+				uint32_t release = Emitter::LocalTick(ps.time_to_spawn, delta);
+				Projectile projectile = ps.projectile_to_spawn;
+				projectile.delay += fmaxf(ps.time_to_spawn - float(release) * delta, 0.0f);
+				shot_schedule.Insert(emitter->start_tick + release, ScheduledShot{ handle, projectile });
+			};
+			Vector2 position = transforms.World(emitter->transform);
+			uint32_t wake = emitter->Fire(tick - emitter->start_tick, delta, position, player.position, SpawnSink::Into(schedule_shot));
+			wakeups.Insert(emitter->start_tick + wake, handle);
+		}
+		shot_schedule.PopDue(tick, [&](const ScheduledShot& shot) {
+			Emitter* emitter = emitters.Get(shot.emitter);
+			if (emitter == nullptr) return;
+			// shots fired before the node went away would otherwise keep coming for the rest of the pattern
+			if (not transforms.Contains(emitter->transform)) {
+				emitters.Remove(shot.emitter);
+				return;
+			}
+			enemy_projectiles.Push(shot.projectile);
+		});
+		enemy_projectiles.Update(delta);
+		tick++;
+	}
+
+	// drops bullets that left the killing field
+	void Cull(void) {
+		player_projectiles.RemoveKilled();
+		enemy_projectiles.RemoveKilled();
+	}
+
+	void Collide(void) {
+		destructible_grid.Clear();
+		for (Destructible& destructible : destructibles) {
+			destructible_grid.Insert(&destructible, transforms.World(destructible.transform), destructible.radius);
+		}
+		destructible_grid.Build();
+		for (size_t i = 0; i < player_projectiles.Size(); i++) {
+			player_projectiles.kill[i] = destructible_grid.Query(player_projectiles.position[i], player_projectiles.radius[i], [&](Destructible* destructible) {
+				if (destructible->health <= 0 or not player_projectiles.Collide(i, transforms.World(destructible->transform), destructible->radius)) {
+					return false;
+				}
+				destructible->Hurt();
+				return true;
+			});
+		}
+		for (size_t i = destructibles.Size(); i-- > 0;) {
+			if (destructibles.values[i].health <= 0) RemoveDestructible(i);
+		}
+		for (size_t i = 0; i < enemy_projectiles.Size(); i++) {
+			if (enemy_projectiles.Collide(i, player.position, PLAYER_HITBOX_RADIUS)) {
+			}
+		}
+		if (PLAYER_SHOT_CANCELS_ENEMY_SHOT) {
+			for (const SweepPair& pair : shot_sweep.Sweep(player_projectiles.position.data(), player_projectiles.radius.data(), player_projectiles.Size(),
+				enemy_projectiles.position.data(), enemy_projectiles.radius.data(), enemy_projectiles.Size())) {
+				if (player_projectiles.kill[pair.a] or enemy_projectiles.kill[pair.b]) continue;
+				player_projectiles.kill[pair.a] = 1;
+				enemy_projectiles.kill[pair.b] = 1;
+			}
+		}
+		player_projectiles.RemoveKilled();
+		enemy_projectiles.RemoveKilled();
+	}
+
+	void UpdateDestructibles(float delta) {
+		FrameVector<uint32_t> destructible_to_remove{ ArenaAllocator<uint32_t>(frame_arena) };
+		for (size_t i = 0; i < destructibles.Size(); i++) {
+			Destructible& destructible = destructibles.values[i];
+			if (destructible.Update(delta)) {
+				destructible_to_remove.push_back(uint32_t(i));
+			}
+			transforms.SetLocal(destructible.transform, destructible.position);
+		}
+		for (size_t i = destructible_to_remove.size(); i-- > 0;) {
+			RemoveDestructible(destructible_to_remove[i]);
+		}
+		// once per tick, emitters and hitboxes read world positions from here until the next one
+		transforms.Resolve();
+	}
+
+	// interpolated draw positions, split from Draw so it can be timed without a GL context
+	void PrepareDraw(float alpha, float tick_seconds) {
+		player_projectiles.PrepareDraw(alpha, tick_seconds);
+		enemy_projectiles.PrepareDraw(alpha, tick_seconds);
+	}
+};
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "raylib.h"
+
+#include "game.h"
+#include "bullet_renderer.h"
+
+// Kept out of game.h so borno_sim and borno_bench build without rlgl or the
+// bullet shaders. alpha in [0, 1) blends the last two simulation ticks,
+// tick_seconds is their spacing.
+inline void draw_game(Game& game, float alpha, float tick_seconds, BulletRenderer& bullets) {
+	game.PrepareDraw(alpha, tick_seconds);
+
+	for (Destructible& destructible : game.destructibles) {
+		destructible.Draw(alpha);
+	}
+
+	bullets.Draw(game.player_projectiles);
+
+	bullets.Draw(game.enemy_projectiles);
+
+	game.player.Draw(alpha);
+}
@@ -4,47 +4,281 @@
 #include "raymath.h"
 
 #include <functional>
+#include <vector>
+#include <cmath>
+#include <cstdint>
+#include <utility>
 
-std::function<Vector2(float)> linear(Vector2 from, Vector2 velocity) {
-	return [=](float t) -> Vector2 { return Vector2Add(from, Vector2Scale(velocity, t)); };
+#include "config.h"
+
+enum class TrajectoryKind : uint8_t {
+	Linear,
+	Accelerated,
+	HorizontalBounce,
+	QuadraticBezier,
+	QuadraticBezierWithPause,
+	Custom,
+};
+
+// Closed-form path, copied by value into every projectile and destructible.
+// Bezier kinds reuse the velocity/acceleration slots as to/control.
+struct Trajectory {
+	TrajectoryKind kind;
+	Vector2 from;
+	union {
+		Vector2 velocity;
+		Vector2 to;
+	};
+	union {
+		Vector2 acceleration;
+		Vector2 control;
+	};
+	float travel_time;
+	float pause_at;
+	float pause_for;
+	uint32_t custom;
+};
+
+// Custom shapes are registered once and shared by every trajectory that uses them,
+// the shape is evaluated relative to Trajectory::from.
+inline std::vector<std::function<Vector2(float)>>& custom_trajectory_table(void) {
+	static std::vector<std::function<Vector2(float)>> table;
+	return table;
 }
 
-std::function<Vector2(float)> accelerated(Vector2 from, Vector2 velocity, Vector2 acceleration) {
-	return [=](float t) -> Vector2 { return Vector2Add(from, Vector2Add(Vector2Scale(velocity, t), Vector2Scale(acceleration, 0.5f * t * t))); };
+inline uint32_t register_custom_trajectory(std::function<Vector2(float)> shape) {
+	custom_trajectory_table().push_back(std::move(shape));
+	return uint32_t(custom_trajectory_table().size() - 1);
 }
 
-std::function<Vector2(float)> horizontal_bounce(Vector2 from, Vector2 velocity) {
-	bool nvx = velocity.x < 0;
-	return [=](float t) -> Vector2 {
-		float horizontal_distance = from.x + velocity.x * t - PLAYING_FIELD_TOP_LEFT.x;
-		int bounces = int(fabsf(horizontal_distance / PLAYING_FIELD_RECT.width)) + (nvx and horizontal_distance < 0) ? 1 : 0;
-		float local_distance = fmodf(fmodf(horizontal_distance, PLAYING_FIELD_RECT.width) + PLAYING_FIELD_RECT.width, PLAYING_FIELD_RECT.width);
+inline Trajectory linear(Vector2 from, Vector2 velocity) {
+	Trajectory trajectory{ TrajectoryKind::Linear, from };
+	trajectory.velocity = velocity;
+	trajectory.acceleration = Vector2Zero();
+	return trajectory;
+}
 
-		return Vector2{ PLAYING_FIELD_TOP_LEFT.x + (bounces % 2 == 0 ? local_distance : PLAYING_FIELD_RECT.width - local_distance), from.y + velocity.y * t };
-	};
+inline Trajectory accelerated(Vector2 from, Vector2 velocity, Vector2 acceleration) {
+	Trajectory trajectory{ TrajectoryKind::Accelerated, from };
+	trajectory.velocity = velocity;
+	trajectory.acceleration = acceleration;
+	return trajectory;
 }
 
-std::function<Vector2(float)> quadratic_bezier(Vector2 from, Vector2 to, Vector2 control, float travel_time = 1.0f) {
-	return [=](float u) -> Vector2 {
-		u /= travel_time;
-		return Vector2Lerp(Vector2Lerp(from, control, u), Vector2Lerp(control, to, u), u);
-	};
+inline Trajectory horizontal_bounce(Vector2 from, Vector2 velocity) {
+	Trajectory trajectory{ TrajectoryKind::HorizontalBounce, from };
+	trajectory.velocity = velocity;
+	trajectory.acceleration = Vector2Zero();
+	return trajectory;
+}
+
+inline Trajectory quadratic_bezier(Vector2 from, Vector2 to, Vector2 control, float travel_time = 1.0f) {
+	Trajectory trajectory{ TrajectoryKind::QuadraticBezier, from };
+	trajectory.to = to;
+	trajectory.control = control;
+	trajectory.travel_time = travel_time;
+	return trajectory;
 }
 
-std::function<Vector2(float)> quadratic_bezier_with_pause(Vector2 from, Vector2 to, Vector2 control, float travel_time = 1.0f, float pause_at = 0.5f, float pause_for = 1.0f) {
-	return [=](float t) -> Vector2 {
+inline Trajectory quadratic_bezier_with_pause(Vector2 from, Vector2 to, Vector2 control, float travel_time = 1.0f, float pause_at = 0.5f, float pause_for = 1.0f) {
+	Trajectory trajectory{ TrajectoryKind::QuadraticBezierWithPause, from };
+	trajectory.to = to;
+	trajectory.control = control;
+	trajectory.travel_time = travel_time;
+	trajectory.pause_at = pause_at;
+	trajectory.pause_for = pause_for;
+	return trajectory;
+}
+
+inline Trajectory custom(Vector2 from, uint32_t shape) {
+	Trajectory trajectory{ TrajectoryKind::Custom, from };
+	trajectory.velocity = Vector2Zero();
+	trajectory.acceleration = Vector2Zero();
+	trajectory.custom = shape;
+	return trajectory;
+}
+
+// triangle wave between the playing field walls
+inline float bounce_x(float from_x, float velocity_x, float t) {
+	float width = PLAYING_FIELD_RECT.width;
+	float horizontal_distance = from_x + velocity_x * t - PLAYING_FIELD_TOP_LEFT.x;
+	float phase = horizontal_distance - 2.0f * width * floorf(horizontal_distance / (2.0f * width));
+	return PLAYING_FIELD_TOP_LEFT.x + width - fabsf(phase - width);
+}
+
+inline Vector2 bezier_point(Vector2 from, Vector2 to, Vector2 control, float u) {
+	return Vector2Lerp(Vector2Lerp(from, control, u), Vector2Lerp(control, to, u), u);
+}
+
+inline Vector2 interpolate(const Trajectory& trajectory, float t) {
+	switch (trajectory.kind) {
+	case TrajectoryKind::Linear:
+		return Vector2Add(trajectory.from, Vector2Scale(trajectory.velocity, t));
+	case TrajectoryKind::Accelerated:
+		return Vector2Add(trajectory.from, Vector2Add(Vector2Scale(trajectory.velocity, t), Vector2Scale(trajectory.acceleration, 0.5f * t * t)));
+	case TrajectoryKind::HorizontalBounce:
+		return Vector2{ bounce_x(trajectory.from.x, trajectory.velocity.x, t), trajectory.from.y + trajectory.velocity.y * t };
+	case TrajectoryKind::QuadraticBezier:
+		return bezier_point(trajectory.from, trajectory.to, trajectory.control, t / trajectory.travel_time);
+	case TrajectoryKind::QuadraticBezierWithPause: {
 		float u;
 
-		if (t <= pause_at) {
-			u = t / travel_time;
+		if (t <= trajectory.pause_at) {
+			u = t / trajectory.travel_time;
 		}
-		else if (t > pause_at and t <= pause_at + pause_for) {
-			u = pause_at / travel_time;
+		else if (t > trajectory.pause_at and t <= trajectory.pause_at + trajectory.pause_for) {
+			u = trajectory.pause_at / trajectory.travel_time;
 		}
 		else {
-			u = (t - pause_for) / travel_time;
+			u = (t - trajectory.pause_for) / trajectory.travel_time;
 		}
 
-		return Vector2Lerp(Vector2Lerp(from, control, u), Vector2Lerp(control, to, u), u);
+		return bezier_point(trajectory.from, trajectory.to, trajectory.control, u);
+	}
+	case TrajectoryKind::Custom:
+		return Vector2Add(trajectory.from, custom_trajectory_table()[trajectory.custom](t));
+	}
+	return trajectory.from;
+}
+
+// real roots of a * t^2 + b * t + c = 0, returns how many
+inline int quadratic_roots(double a, double b, double c, double roots[2]) {
+	if (a == 0.0) {
+		if (b == 0.0) return 0;
+		roots[0] = -c / b;
+		return 1;
+	}
+	double discriminant = b * b - 4.0 * a * c;
+	if (discriminant < 0.0) return 0;
+	double q = -0.5 * (b + (b < 0.0 ? -1.0 : 1.0) * sqrt(discriminant));
+	roots[0] = q / a;
+	roots[1] = q != 0.0 ? c / q : roots[0];
+	if (roots[0] > roots[1]) std::swap(roots[0], roots[1]);
+	return 2;
+}
+
+// smallest t > 0 with a * t^2 + b * t + c = 0, INFINITY if there is none
+inline double first_positive_root(double a, double b, double c) {
+	double roots[2];
+	int count = quadratic_roots(a, b, c, roots);
+	for (int i = 0; i < count; i++) {
+		if (roots[i] > 0.0) return roots[i];
+	}
+	return INFINITY;
+}
+
+// from + velocity * t + acceleration * t^2 / 2, the shape linear and accelerated
+// paths have in t and both bezier kinds have in the curve parameter
+struct QuadraticPath {
+	Vector2 from;
+	Vector2 velocity;
+	Vector2 acceleration;
+};
+
+inline Vector2 quadratic_path_point(const QuadraticPath& path, double t) {
+	return Vector2{ float(path.from.x + path.velocity.x * t + 0.5 * path.acceleration.x * t * t),
+		float(path.from.y + path.velocity.y * t + 0.5 * path.acceleration.y * t * t) };
+}
+
+// The path of a trajectory kind in quadratic form, false for bounce and custom.
+// Bezier kinds are in the curve parameter u, a pause only stalls it.
+inline bool trajectory_quadratic_path(const Trajectory& trajectory, QuadraticPath& path) {
+	switch (trajectory.kind) {
+	case TrajectoryKind::Linear:
+		path = QuadraticPath{ trajectory.from, trajectory.velocity, Vector2Zero() };
+		return true;
+	case TrajectoryKind::Accelerated:
+		path = QuadraticPath{ trajectory.from, trajectory.velocity, trajectory.acceleration };
+		return true;
+	case TrajectoryKind::QuadraticBezier:
+	case TrajectoryKind::QuadraticBezierWithPause: {
+		Vector2 from = trajectory.from, control = trajectory.control, to = trajectory.to;
+		path = QuadraticPath{
+			from,
+			Vector2Scale(Vector2Subtract(control, from), 2.0f),
+			Vector2Scale(Vector2Add(Vector2Subtract(from, Vector2Scale(control, 2.0f)), to), 2.0f)
+		};
+		return true;
+	}
+	default:
+		return false;
+	}
+}
+
+// first t at which path leaves the killing field, INFINITY if it never does and 0 if it starts outside
+inline double quadratic_path_exit_time(const QuadraticPath& path) {
+	Vector2 from = path.from;
+	if (from.x < KILLING_FIELD_TOP_LEFT.x or from.x > KILLING_FIELD_BOTTOM_RIGHT.x or
+		from.y < KILLING_FIELD_TOP_LEFT.y or from.y > KILLING_FIELD_BOTTOM_RIGHT.y) {
+		return 0.0;
+	}
+	double t = INFINITY;
+	t = fmin(t, first_positive_root(0.5 * path.acceleration.x, path.velocity.x, from.x - KILLING_FIELD_TOP_LEFT.x));
+	t = fmin(t, first_positive_root(0.5 * path.acceleration.x, path.velocity.x, from.x - KILLING_FIELD_BOTTOM_RIGHT.x));
+	t = fmin(t, first_positive_root(0.5 * path.acceleration.y, path.velocity.y, from.y - KILLING_FIELD_TOP_LEFT.y));
+	t = fmin(t, first_positive_root(0.5 * path.acceleration.y, path.velocity.y, from.y - KILLING_FIELD_BOTTOM_RIGHT.y));
+	return t;
+}
+
+// First time a linear or accelerated trajectory leaves the killing field, false
+// for kinds whose exit time is not a closed form of et.
+inline bool killing_field_exit_time(const Trajectory& trajectory, float& exit) {
+	if (trajectory.kind != TrajectoryKind::Linear and trajectory.kind != TrajectoryKind::Accelerated) return false;
+	QuadraticPath path;
+	trajectory_quadratic_path(trajectory, path);
+	exit = float(quadratic_path_exit_time(path));
+	return true;
+}
+
+// Whether a circle of radius on path overlaps rect at some t in [0, until].
+// Between consecutive times where a coordinate crosses a rect edge the answer
+// cannot change, so it is enough to test those times and the midpoints.
+inline bool quadratic_path_overlaps(const QuadraticPath& path, Rectangle rect, float radius, double until) {
+	double lo[2] = { rect.x - radius, rect.y - radius };
+	double hi[2] = { rect.x + rect.width + radius, rect.y + rect.height + radius };
+	double from[2] = { path.from.x, path.from.y };
+	double velocity[2] = { path.velocity.x, path.velocity.y };
+	double acceleration[2] = { path.acceleration.x, path.acceleration.y };
+
+	double times[10];
+	int count = 0;
+	times[count++] = 0.0;
+	for (int axis = 0; axis < 2; axis++) {
+		for (double edge : { lo[axis], hi[axis] }) {
+			double roots[2];
+			int root_count = quadratic_roots(0.5 * acceleration[axis], velocity[axis], from[axis] - edge, roots);
+			for (int i = 0; i < root_count; i++) {
+				if (roots[i] > 0.0 and roots[i] < until) times[count++] = roots[i];
+			}
+		}
+	}
+	for (int i = 1; i < count; i++) {
+		for (int j = i; j > 0 and times[j - 1] > times[j]; j--) std::swap(times[j - 1], times[j]);
+	}
+	// past the last crossing nothing changes either, one probe beyond it stands for the rest
+	double last = std::isinf(until) ? times[count - 1] + 1.0 : until;
+
+	auto inside = [&](double t) {
+		Vector2 p = quadratic_path_point(path, t);
+		return p.x >= lo[0] and p.x <= hi[0] and p.y >= lo[1] and p.y <= hi[1];
 	};
-}
\ No newline at end of file
+	for (int i = 0; i < count; i++) {
+		double next = i + 1 < count ? times[i + 1] : last;
+		if (inside(times[i]) or inside(0.5 * (times[i] + next))) return true;
+	}
+	return inside(last);
+}
+
+// False only for shots that provably never overlap PLAYING_FIELD_RECT before
+// they leave the killing field, paths with no closed form are kept.
+inline bool may_enter_playing_field(const Trajectory& trajectory, float radius) {
+	QuadraticPath path;
+	if (trajectory.kind == TrajectoryKind::HorizontalBounce) {
+		// x stays between the walls, only y decides
+		path = QuadraticPath{ Vector2{ PLAYING_FIELD_RECT.x, trajectory.from.y }, Vector2{ 0.0f, trajectory.velocity.y }, Vector2Zero() };
+	}
+	else if (not trajectory_quadratic_path(trajectory, path)) {
+		return true;
+	}
+	return quadratic_path_overlaps(path, PLAYING_FIELD_RECT, radius, quadratic_path_exit_time(path));
+}
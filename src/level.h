@@ -0,0 +1,116 @@
+#pragma once
+
+#include "raylib.h"
+#include "raymath.h"
+
+#include <vector>
+
+#include "config.h"
+#include "game.h"
+
+// spawn times are absolute, seconds since the level started
+inline std::vector<DestructibleSpawner> get_test_level(void) {
+	std::vector<DestructibleSpawner> test_level;
+
+	//test_level.push_back(
+	//	DestructibleSpawner{
+	//		0.01f,
+	//		Destructible{
+	//			POPCORN_RADIUS,
+	//			BLUE,
+	//			quadratic_bezier_with_pause(
+	//				PLAYING_FIELD_TOP_LEFT,
+	//				Vector2{ PLAYING_FIELD_BOTTOM_RIGHT.x, PLAYING_FIELD_TOP_LEFT.y },
+	//				Vector2Scale(Vector2Add(PLAYING_FIELD_TOP_LEFT, PLAYING_FIELD_BOTTOM_RIGHT), 0.5f),
+	//				2.0f,
+	//				1.0f,
+	//				3.0f
+	//			),
+	//			TESTING_DUMMY_HEALTH
+	//		},
+	//		single_aimed_shot(0.2f)
+	//	}
+	//);
+
+	//test_level.push_back(
+	//	DestructibleSpawner{
+	//		5.01f,
+	//		Destructible{
+	//			POPCORN_RADIUS,
+	//			BLUE,
+	//			quadratic_bezier_with_pause(
+	//				PLAYING_FIELD_TOP_LEFT, 
+	//				Vector2{ PLAYING_FIELD_BOTTOM_RIGHT.x, PLAYING_FIELD_TOP_LEFT.y }, 
+	//				Vector2Scale(Vector2Add(PLAYING_FIELD_TOP_LEFT, PLAYING_FIELD_BOTTOM_RIGHT), 0.5f),
+	//				2.0f,
+	//				1.0f,
+	//				3.0f
+	//			),
+	//			TESTING_DUMMY_HEALTH
+	//		},
+	//		linear_aim_ring_pattern(10, 50.0f, 1.0f, 0.0f)
+	//	}
+	//);
+
+	//test_level.push_back(
+	//	DestructibleSpawner{
+	//		10.01f,
+	//		Destructible{
+	//			POPCORN_RADIUS,
+	//			BLUE,
+	//			quadratic_bezier_with_pause(
+	//				PLAYING_FIELD_TOP_LEFT,
+	//				Vector2{ PLAYING_FIELD_BOTTOM_RIGHT.x, PLAYING_FIELD_TOP_LEFT.y },
+	//				Vector2Scale(Vector2Add(PLAYING_FIELD_TOP_LEFT, PLAYING_FIELD_BOTTOM_RIGHT), 0.5f),
+	//				2.0f,
+	//				1.0f,
+	//				3.0f
+	//			),
+	//			TESTING_DUMMY_HEALTH
+	//		},
+	//		linear_ring(12, 1.0f, 0.0f)
+	//	}
+	//);
+
+	//test_level.push_back(
+	//	DestructibleSpawner{
+	//		15.01f,
+	//		Destructible{
+	//			POPCORN_RADIUS,
+	//			BLUE,
+	//			quadratic_bezier_with_pause(
+	//				PLAYING_FIELD_TOP_LEFT,
+	//				Vector2{ PLAYING_FIELD_BOTTOM_RIGHT.x, PLAYING_FIELD_TOP_LEFT.y },
+	//				Vector2Scale(Vector2Add(PLAYING_FIELD_TOP_LEFT, PLAYING_FIELD_BOTTOM_RIGHT), 0.5f),
+	//				2.0f,
+	//				1.0f,
+	//				3.0f
+	//			),
+	//			TESTING_DUMMY_HEALTH
+	//		},
+	//		linear_spinny_ring(12, 2.5f, 0.0f, 2.0f, 0.5f, PI)
+	//	}
+	//);
+
+	test_level.push_back(
+		DestructibleSpawner{
+			0.01f,
+			Destructible{
+				POPCORN_RADIUS,
+				BLUE,
+				quadratic_bezier_with_pause(
+					PLAYING_FIELD_TOP_LEFT,
+					Vector2{ PLAYING_FIELD_BOTTOM_RIGHT.x, PLAYING_FIELD_TOP_LEFT.y },
+					Vector2Scale(Vector2Add(PLAYING_FIELD_TOP_LEFT, PLAYING_FIELD_BOTTOM_RIGHT), 0.5f),
+					2.0f,
+					1.0f,
+					3.0f
+				),
+				TESTING_DUMMY_HEALTH
+			},
+			linear_spinny_ring(12, 2.5f, 0.0f, 2.0f, 0.1f, PI)
+		}
+	);
+
+	return test_level;
+}
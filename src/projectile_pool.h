@@ -0,0 +1,287 @@
+#pragma once
+
+#include "raylib.h"
+#include "raymath.h"
+
+#include <vector>
+#include <cfloat>
+#include <cstdint>
+
+#include "config.h"
+#include "interpolate_fn.h"
+#include "trajectory_kernels.h"
+#include "projectile.h"
+#include "timer_wheel.h"
+
+constexpr size_t TRAJECTORY_KIND_COUNT = size_t(TrajectoryKind::Custom) + 1;
+// exit times this close past a tick boundary, in ticks, count as on it
+constexpr float EXPIRY_TICK_EPSILON = 1e-3f;
+
+// a bullet with a closed-form exit time, delay and travel are seconds from when it was pushed
+struct BulletExpiry {
+	uint32_t id;
+	uint32_t generation;
+	float delay;
+	float travel;
+};
+
+// Bullets are kept in one contiguous run per TrajectoryKind, in enum order,
+// so every kind is evaluated by its batch kernel in a single pass.
+//
+// Linear and accelerated bullets get their killing field exit time solved
+// when pushed and are retired by an expiry wheel keyed on Update count, their
+// kernels skip the bounds test. Slots move, so the wheel refers to bullets by
+// a stable id, the generation tells a reused id from the one it was made for.
+struct ProjectilePool {
+	std::vector<Vector2> position;
+	std::vector<Vector2> velocity;
+	std::vector<float> radius;
+	std::vector<Color> color;
+	std::vector<float> et;
+	std::vector<float> delay;
+	std::vector<uint8_t> kill;
+
+	std::vector<Vector2> path_from;
+	std::vector<Vector2> path_velocity;
+	std::vector<Vector2> path_acceleration;
+	std::vector<float> path_travel_time;
+	std::vector<float> path_pause_at;
+	std::vector<float> path_pause_for;
+	std::vector<uint32_t> path_custom;
+	std::vector<float> path_u;
+	std::vector<uint32_t> id;
+
+	size_t segment_end[TRAJECTORY_KIND_COUNT] = {};
+
+	std::vector<uint32_t> id_index;
+	std::vector<uint32_t> id_generation;
+	std::vector<uint32_t> free_ids;
+	// pushed since the last Update, which knows the tick length to schedule them with
+	std::vector<BulletExpiry> pending_expiry;
+	TimerWheel<BulletExpiry> expiry;
+	uint32_t tick = 0;
+
+	// filled by PrepareDraw, not kept in step with the columns above
+	std::vector<Vector2> draw_position;
+
+	template <typename F>
+	void ForEachColumn(F f) {
+		f(position);
+		f(velocity);
+		f(radius);
+		f(color);
+		f(et);
+		f(delay);
+		f(kill);
+		f(path_from);
+		f(path_velocity);
+		f(path_acceleration);
+		f(path_travel_time);
+		f(path_pause_at);
+		f(path_pause_for);
+		f(path_custom);
+		f(path_u);
+		f(id);
+	}
+
+	inline size_t Size(void) const {
+		return position.size();
+	}
+
+	inline size_t SegmentBegin(TrajectoryKind kind) const {
+		return kind == TrajectoryKind::Linear ? 0 : segment_end[size_t(kind) - 1];
+	}
+
+	inline size_t SegmentEnd(TrajectoryKind kind) const {
+		return segment_end[size_t(kind)];
+	}
+
+	inline void Move(size_t from, size_t to) {
+		ForEachColumn([=](auto& column) { column[to] = column[from]; });
+		id_index[id[to]] = uint32_t(to);
+	}
+
+	uint32_t AcquireId(void) {
+		if (free_ids.empty()) {
+			id_index.push_back(0);
+			id_generation.push_back(0);
+			return uint32_t(id_index.size() - 1);
+		}
+		uint32_t bullet_id = free_ids.back();
+		free_ids.pop_back();
+		return bullet_id;
+	}
+
+	inline void ReleaseId(uint32_t bullet_id) {
+		id_generation[bullet_id]++;
+		free_ids.push_back(bullet_id);
+	}
+
+	void Push(const Projectile& projectile) {
+		const Trajectory& trajectory = projectile.trajectory;
+		size_t k = size_t(trajectory.kind);
+
+		ForEachColumn([](auto& column) { column.emplace_back(); });
+		for (size_t j = TRAJECTORY_KIND_COUNT - 1; j > k; j--) {
+			if (segment_end[j - 1] != segment_end[j]) {
+				Move(segment_end[j - 1], segment_end[j]);
+			}
+			segment_end[j]++;
+		}
+		size_t i = segment_end[k]++;
+
+		position[i] = interpolate(trajectory, projectile.et);
+		velocity[i] = Vector2Zero();
+		radius[i] = projectile.radius;
+		color[i] = projectile.color;
+		et[i] = projectile.et;
+		delay[i] = projectile.delay;
+		kill[i] = 0;
+		path_from[i] = trajectory.from;
+		path_velocity[i] = trajectory.velocity;
+		path_acceleration[i] = trajectory.acceleration;
+		path_travel_time[i] = trajectory.travel_time;
+		path_pause_at[i] = trajectory.kind == TrajectoryKind::QuadraticBezierWithPause ? trajectory.pause_at : FLT_MAX;
+		path_pause_for[i] = trajectory.kind == TrajectoryKind::QuadraticBezierWithPause ? trajectory.pause_for : 0.0f;
+		path_custom[i] = trajectory.custom;
+		path_u[i] = 0.0f;
+		id[i] = AcquireId();
+		id_index[id[i]] = uint32_t(i);
+
+		float exit;
+		if (killing_field_exit_time(trajectory, exit)) {
+			pending_expiry.push_back(BulletExpiry{ id[i], id_generation[id[i]], projectile.delay, exit - projectile.et });
+		}
+	}
+
+	// fills the hole from the end of its own run and then shifts every later run down by one,
+	// only slots at or after i move so removing while iterating backwards is safe
+	void Remove(size_t i) {
+		ReleaseId(id[i]);
+		size_t k = 0;
+		while (segment_end[k] <= i) k++;
+
+		size_t hole = i;
+		for (size_t j = k; j < TRAJECTORY_KIND_COUNT; j++) {
+			size_t last = segment_end[j] - 1;
+			if (hole != last) {
+				Move(last, hole);
+			}
+			hole = last;
+			segment_end[j]--;
+		}
+		ForEachColumn([](auto& column) { column.pop_back(); });
+	}
+
+	// columns only grow past capacity, so a pool sized for the stage never allocates
+	void Reserve(size_t capacity) {
+		ForEachColumn([=](auto& column) { column.reserve(capacity); });
+		draw_position.reserve(capacity);
+		id_index.reserve(capacity);
+		id_generation.reserve(capacity);
+		free_ids.reserve(capacity);
+		pending_expiry.reserve(capacity);
+	}
+
+	void Clear(void) {
+		for (uint32_t bullet_id : id) ReleaseId(bullet_id);
+		pending_expiry.clear();
+		ForEachColumn([](auto& column) { column.clear(); });
+		for (size_t& end : segment_end) end = 0;
+	}
+
+	// without bounds_test the kernel leaves kill alone
+	inline TrajectoryBatch Batch(size_t begin, size_t end, const float* t, float inv_delta, bool bounds_test = true) {
+		return TrajectoryBatch{
+			path_from.data() + begin,
+			path_velocity.data() + begin,
+			path_acceleration.data() + begin,
+			t + begin,
+			position.data() + begin,
+			velocity.data() + begin,
+			bounds_test ? kill.data() + begin : nullptr,
+			end - begin,
+			inv_delta
+		};
+	}
+
+	// Update count at which a pending bullet has moved past its exit time
+	inline uint32_t ExpiryTick(const BulletExpiry& pending, float delta) const {
+		float ticks = ceilf((fmaxf(pending.delay, 0.0f) + pending.travel) / delta - EXPIRY_TICK_EPSILON);
+		if (not (ticks < float(UINT32_MAX - tick))) return UINT32_MAX;
+		return ticks > 1.0f ? tick + uint32_t(ticks) - 1 : tick;
+	}
+
+	// advances every bullet, kill[i] is set for bullets that left the killing field
+	void Update(float delta) {
+		if (delta > 0.0f) {
+			for (const BulletExpiry& pending : pending_expiry) {
+				uint32_t due = ExpiryTick(pending, delta);
+				if (due != UINT32_MAX) expiry.Insert(due, pending);
+			}
+			pending_expiry.clear();
+		}
+
+		// whatever is left of the tick once the delay runs out already moves the bullet
+		for (size_t i = 0; i < Size(); i++) {
+			if (delay[i] <= 0.0f) {
+				et[i] += delta;
+			}
+			else {
+				float held = delay[i] < delta ? delay[i] : delta;
+				delay[i] -= held;
+				et[i] += delta - held;
+			}
+		}
+
+		float inv_delta = delta > 0.0f ? 1.0f / delta : 0.0f;
+
+		linear_kernel(Batch(SegmentBegin(TrajectoryKind::Linear), SegmentEnd(TrajectoryKind::Linear), et.data(), inv_delta, false));
+		accelerated_kernel(Batch(SegmentBegin(TrajectoryKind::Accelerated), SegmentEnd(TrajectoryKind::Accelerated), et.data(), inv_delta, false));
+		expiry.PopDue(tick, [&](const BulletExpiry& due) {
+			if (id_generation[due.id] == due.generation) kill[id_index[due.id]] = 1;
+		});
+		horizontal_bounce_kernel(Batch(SegmentBegin(TrajectoryKind::HorizontalBounce), SegmentEnd(TrajectoryKind::HorizontalBounce), et.data(), inv_delta));
+
+		size_t bezier_begin = SegmentBegin(TrajectoryKind::QuadraticBezier);
+		size_t bezier_end = SegmentEnd(TrajectoryKind::QuadraticBezierWithPause);
+		for (size_t i = bezier_begin; i < bezier_end; i++) {
+			float t = et[i];
+			path_u[i] = (fminf(t, path_pause_at[i]) + fmaxf(t - path_pause_at[i] - path_pause_for[i], 0.0f)) / path_travel_time[i];
+		}
+		quadratic_bezier_kernel(Batch(bezier_begin, bezier_end, path_u.data(), inv_delta));
+
+		for (size_t i = SegmentBegin(TrajectoryKind::Custom); i < SegmentEnd(TrajectoryKind::Custom); i++) {
+			Vector2 next_position = Vector2Add(path_from[i], custom_trajectory_table()[path_custom[i]](et[i]));
+			velocity[i] = Vector2Scale(Vector2Subtract(next_position, position[i]), inv_delta);
+			position[i] = next_position;
+			kill[i] = outside_killing_field(next_position);
+		}
+
+		tick++;
+	}
+
+	inline bool Collide(size_t i, Vector2 c_position, float c_radius) const {
+		return Vector2DistanceSqr(position[i], c_position) < sqr(radius[i] + c_radius);
+	}
+
+	void RemoveKilled(void) {
+		for (size_t i = Size(); i-- > 0;) {
+			if (kill[i]) Remove(i);
+		}
+	}
+
+	// alpha is how far the renderer is between the previous tick and this one
+	void PrepareDraw(float alpha, float tick_seconds) {
+		float lag = (1.0f - alpha) * tick_seconds;
+		draw_position.resize(Size());
+		for (size_t i = 0; i < Size(); i++) {
+			draw_position[i] = Vector2Subtract(position[i], Vector2Scale(velocity[i], lag));
+		}
+	}
+
+	// one batched call, segment count follows radius
+	void Draw(void) const {
+		DrawCirclesV(draw_position.data(), radius.data(), color.data(), int(Size()));
+	}
+};
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+constexpr uint32_t SLOT_MAP_INDEX_BITS = 20;
+constexpr uint32_t SLOT_MAP_INDEX_MASK = (1u << SLOT_MAP_INDEX_BITS) - 1;
+constexpr uint32_t SLOT_MAP_GENERATION_MASK = (1u << (32 - SLOT_MAP_INDEX_BITS)) - 1;
+
+// Slot index in the low bits, generation in the high bits. Generation 0 is
+// never handed out, so the zero handle is always stale.
+struct SlotHandle {
+	uint32_t value = 0;
+
+	inline uint32_t Index(void) const {
+		return value & SLOT_MAP_INDEX_MASK;
+	}
+
+	inline uint32_t Generation(void) const {
+		return value >> SLOT_MAP_INDEX_BITS;
+	}
+
+	inline bool IsNull(void) const {
+		return value == 0;
+	}
+
+	inline bool operator==(SlotHandle other) const {
+		return value == other.value;
+	}
+
+	inline bool operator!=(SlotHandle other) const {
+		return value != other.value;
+	}
+};
+
+// Generational slot map. Values live in one dense array that iterates
+// without holes, removal fills the hole with the last value. Slots map a
+// handle to its dense position and bump their generation on removal, so a
+// handle to a removed value stays detectably stale after its slot is reused.
+template <typename T>
+struct SlotMap {
+	struct Slot {
+		uint32_t dense;
+		uint32_t generation;
+	};
+
+	std::vector<T> values;
+	std::vector<uint32_t> dense_slot;
+	std::vector<Slot> slots;
+	std::vector<uint32_t> free_slots;
+
+	inline size_t Size(void) const {
+		return values.size();
+	}
+
+	inline bool Empty(void) const {
+		return values.empty();
+	}
+
+	void Reserve(size_t capacity) {
+		values.reserve(capacity);
+		dense_slot.reserve(capacity);
+		slots.reserve(capacity);
+		free_slots.reserve(capacity);
+	}
+
+	// room for extra more values, growing geometrically so repeated batches stay amortized
+	void ReserveMore(size_t extra) {
+		size_t needed = values.size() + extra;
+		if (needed <= values.capacity()) return;
+		Reserve(needed > 2 * values.capacity() ? needed : 2 * values.capacity());
+	}
+
+	SlotHandle Insert(T value) {
+		uint32_t slot;
+		if (free_slots.empty()) {
+			slot = uint32_t(slots.size());
+			slots.push_back(Slot{ 0, 1 });
+		}
+		else {
+			slot = free_slots.back();
+			free_slots.pop_back();
+		}
+		slots[slot].dense = uint32_t(values.size());
+		values.push_back(std::move(value));
+		dense_slot.push_back(slot);
+		return SlotHandle{ slots[slot].generation << SLOT_MAP_INDEX_BITS | slot };
+	}
+
+	inline bool Contains(SlotHandle handle) const {
+		return not handle.IsNull() and handle.Index() < slots.size() and slots[handle.Index()].generation == handle.Generation();
+	}
+
+	// nullptr for stale handles
+	inline T* Get(SlotHandle handle) {
+		return Contains(handle) ? &values[slots[handle.Index()].dense] : nullptr;
+	}
+
+	inline SlotHandle HandleAt(size_t dense) const {
+		uint32_t slot = dense_slot[dense];
+		return SlotHandle{ slots[slot].generation << SLOT_MAP_INDEX_BITS | slot };
+	}
+
+	// only the value at dense and the last value move, so removing while
+	// walking the dense array backwards is safe
+	void RemoveAt(size_t dense) {
+		uint32_t slot = dense_slot[dense];
+		size_t last = values.size() - 1;
+		if (dense != last) {
+			values[dense] = std::move(values[last]);
+			dense_slot[dense] = dense_slot[last];
+			slots[dense_slot[dense]].dense = uint32_t(dense);
+		}
+		values.pop_back();
+		dense_slot.pop_back();
+
+		uint32_t generation = (slots[slot].generation + 1) & SLOT_MAP_GENERATION_MASK;
+		slots[slot].generation = generation == 0 ? 1 : generation;
+		free_slots.push_back(slot);
+	}
+
+	bool Remove(SlotHandle handle) {
+		if (not Contains(handle)) return false;
+		RemoveAt(slots[handle.Index()].dense);
+		return true;
+	}
+
+	void Clear(void) {
+		while (not values.empty()) RemoveAt(values.size() - 1);
+	}
+
+	inline typename std::vector<T>::iterator begin(void) {
+		return values.begin();
+	}
+
+	inline typename std::vector<T>::iterator end(void) {
+		return values.end();
+	}
+};
@@ -0,0 +1,105 @@
+#pragma once
+
+#include "raylib.h"
+#include "raymath.h"
+
+#include <vector>
+#include <cstdint>
+
+#include "config.h"
+
+constexpr float BROADPHASE_CELL_WIDTH = BROADPHASE_CELL_HORIZONTAL_TILES * TILE_WIDTH;
+constexpr float BROADPHASE_CELL_HEIGHT = BROADPHASE_CELL_VERTICAL_TILES * TILE_HEIGHT;
+constexpr int BROADPHASE_COLUMNS = (PLAYING_FIELD_HORIZONTAL_TILES + BROADPHASE_CELL_HORIZONTAL_TILES - 1) / BROADPHASE_CELL_HORIZONTAL_TILES;
+constexpr int BROADPHASE_ROWS = (PLAYING_FIELD_VERTICAL_TILES + BROADPHASE_CELL_VERTICAL_TILES - 1) / BROADPHASE_CELL_VERTICAL_TILES;
+
+// below this many items a linear scan beats building and querying the grid,
+// see bench/broadphase.cpp
+constexpr size_t BROADPHASE_GRID_MIN_ITEMS = 24;
+
+// Uniform grid over PLAYING_FIELD_RECT, rebuilt from scratch every tick.
+// Circles outside the playing field land in the border cells. A circle
+// covering several cells is stored in each of them, so a query may visit
+// the same item more than once. Small sets skip the grid and scan linearly.
+template <typename T>
+struct SpatialGrid {
+	struct Entry {
+		T item;
+		int min_column, min_row, max_column, max_row;
+	};
+
+	std::vector<Entry> entries;
+	std::vector<uint32_t> cell_start;
+	std::vector<T> cell_items;
+	std::vector<uint32_t> cursor;
+	size_t min_grid_items = BROADPHASE_GRID_MIN_ITEMS;
+	bool linear = true;
+
+	static inline int ClampCell(int v, int hi) {
+		return v < 0 ? 0 : (v > hi ? hi : v);
+	}
+
+	static inline int Column(float x) {
+		return ClampCell(int(floorf((x - PLAYING_FIELD_RECT.x) * (1.0f / BROADPHASE_CELL_WIDTH))), BROADPHASE_COLUMNS - 1);
+	}
+
+	static inline int Row(float y) {
+		return ClampCell(int(floorf((y - PLAYING_FIELD_RECT.y) * (1.0f / BROADPHASE_CELL_HEIGHT))), BROADPHASE_ROWS - 1);
+	}
+
+	void Clear(void) {
+		entries.clear();
+	}
+
+	void Insert(T item, Vector2 center, float radius) {
+		entries.push_back(Entry{ item, Column(center.x - radius), Row(center.y - radius), Column(center.x + radius), Row(center.y + radius) });
+	}
+
+	// counting sort of the inserted entries into per-cell runs
+	void Build(void) {
+		linear = entries.size() < min_grid_items;
+		if (linear) return;
+		cell_start.assign(BROADPHASE_COLUMNS * BROADPHASE_ROWS + 1, 0);
+		for (const Entry& entry : entries) {
+			for (int row = entry.min_row; row <= entry.max_row; row++) {
+				for (int column = entry.min_column; column <= entry.max_column; column++) {
+					cell_start[row * BROADPHASE_COLUMNS + column + 1]++;
+				}
+			}
+		}
+		for (size_t cell = 1; cell < cell_start.size(); cell++) {
+			cell_start[cell] += cell_start[cell - 1];
+		}
+		cell_items.resize(cell_start.back());
+		cursor.assign(cell_start.begin(), cell_start.end() - 1);
+		for (const Entry& entry : entries) {
+			for (int row = entry.min_row; row <= entry.max_row; row++) {
+				for (int column = entry.min_column; column <= entry.max_column; column++) {
+					cell_items[cursor[row * BROADPHASE_COLUMNS + column]++] = entry.item;
+				}
+			}
+		}
+	}
+
+	// visit(item) returns true to stop the query
+	template <typename F>
+	bool Query(Vector2 center, float radius, F visit) const {
+		if (linear) {
+			for (const Entry& entry : entries) {
+				if (visit(entry.item)) return true;
+			}
+			return false;
+		}
+		int min_column = Column(center.x - radius), max_column = Column(center.x + radius);
+		int min_row = Row(center.y - radius), max_row = Row(center.y + radius);
+		for (int row = min_row; row <= max_row; row++) {
+			for (int column = min_column; column <= max_column; column++) {
+				int cell = row * BROADPHASE_COLUMNS + column;
+				for (uint32_t i = cell_start[cell]; i < cell_start[cell + 1]; i++) {
+					if (visit(cell_items[i])) return true;
+				}
+			}
+		}
+		return false;
+	}
+};
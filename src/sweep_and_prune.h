@@ -0,0 +1,164 @@
+#pragma once
+
+#include "raylib.h"
+#include "raymath.h"
+
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+
+#include "config.h"
+
+constexpr size_t SWEEP_INSERTION_SORT_BUDGET = 8;
+constexpr float SWEEP_COHERENT_DISTANCE = 2.0f * TILE_HEIGHT;
+
+struct SweepPair {
+	uint32_t a;
+	uint32_t b;
+};
+
+// Sort-and-sweep along y between two sets of circles, e.g. two ProjectilePools.
+// The sorted order of each set is kept between calls and repaired with an
+// insertion sort, which is close to linear while bullets move coherently.
+// New indices and slots refilled by swap-and-pop are sorted on their own and
+// merged in, a full sort is the fallback once the insertion sort runs long.
+// Every buffer is kept between calls, a steady tick does not allocate.
+struct SweepAndPrune {
+	struct Set {
+		std::vector<uint32_t> order;
+		std::vector<float> lower;
+		std::vector<float> previous_lower;
+	};
+
+	Set set_a;
+	Set set_b;
+	std::vector<uint32_t> active_a;
+	std::vector<uint32_t> active_b;
+	std::vector<uint8_t> seen;
+	std::vector<uint32_t> fresh;
+	std::vector<uint32_t> merged;
+	std::vector<SweepPair> pairs;
+
+	void Reserve(size_t count_a, size_t count_b) {
+		auto reserve_set = [](Set& set, size_t count) {
+			set.order.reserve(count);
+			set.lower.reserve(count);
+			set.previous_lower.reserve(count);
+		};
+		reserve_set(set_a, count_a);
+		reserve_set(set_b, count_b);
+		size_t count = count_a > count_b ? count_a : count_b;
+		active_a.reserve(count_a);
+		active_b.reserve(count_b);
+		seen.reserve(count);
+		fresh.reserve(count);
+		merged.reserve(count);
+		pairs.reserve(count);
+	}
+
+	static inline bool Overlap(Vector2 position_a, float radius_a, Vector2 position_b, float radius_b) {
+		float reach = radius_a + radius_b;
+		return Vector2DistanceSqr(position_a, position_b) < reach * reach;
+	}
+
+	void Refresh(Set& set, const Vector2* position, const float* radius, size_t count) {
+		std::vector<uint32_t>& order = set.order;
+		std::vector<float>& lower = set.lower;
+		std::vector<float>& previous_lower = set.previous_lower;
+		previous_lower.swap(lower);
+		lower.resize(count);
+		for (size_t i = 0; i < count; i++) {
+			lower[i] = position[i].y - radius[i];
+		}
+
+		// an index whose key jumped was refilled by swap-and-pop, it joins the new spawns
+		seen.assign(count, 0);
+		size_t kept = 0;
+		for (uint32_t index : order) {
+			if (index < count and index < previous_lower.size() and fabsf(lower[index] - previous_lower[index]) <= SWEEP_COHERENT_DISTANCE) {
+				seen[index] = 1;
+				order[kept++] = index;
+			}
+		}
+		order.resize(kept);
+		fresh.clear();
+		for (uint32_t i = 0; i < count; i++) {
+			if (not seen[i]) fresh.push_back(i);
+		}
+
+		// ties broken on index so std::sort, which needs no scratch buffer, is deterministic
+		auto by_lower = [&](uint32_t l, uint32_t r) { return lower[l] < lower[r] or (lower[l] == lower[r] and l < r); };
+
+		size_t budget = SWEEP_INSERTION_SORT_BUDGET * order.size();
+		for (size_t i = 1; i < order.size(); i++) {
+			uint32_t index = order[i];
+			size_t j = i;
+			while (j > 0 and by_lower(index, order[j - 1])) {
+				order[j] = order[j - 1];
+				j--;
+			}
+			order[j] = index;
+			budget -= i - j < budget ? i - j : budget;
+			if (budget == 0) {
+				std::sort(order.begin(), order.end(), by_lower);
+				break;
+			}
+		}
+
+		std::sort(fresh.begin(), fresh.end(), by_lower);
+		merged.resize(count);
+		std::merge(order.begin(), order.end(), fresh.begin(), fresh.end(), merged.begin(), by_lower);
+		order.swap(merged);
+	}
+
+	// overlapping (a, b) pairs sorted by a then b
+	const std::vector<SweepPair>& Sweep(const Vector2* position_a, const float* radius_a, size_t count_a,
+		const Vector2* position_b, const float* radius_b, size_t count_b) {
+		pairs.clear();
+		if (count_a == 0 or count_b == 0) return pairs;
+
+		Refresh(set_a, position_a, radius_a, count_a);
+		Refresh(set_b, position_b, radius_b, count_b);
+		const std::vector<uint32_t>& order_a = set_a.order;
+		const std::vector<uint32_t>& order_b = set_b.order;
+		const std::vector<float>& lower_a = set_a.lower;
+		const std::vector<float>& lower_b = set_b.lower;
+
+		active_a.clear();
+		active_b.clear();
+
+		auto prune = [](std::vector<uint32_t>& active, const Vector2* position, const float* radius, float y) {
+			size_t kept = 0;
+			for (uint32_t index : active) {
+				if (position[index].y + radius[index] >= y) active[kept++] = index;
+			}
+			active.resize(kept);
+		};
+
+		size_t i = 0, j = 0;
+		while (i < order_a.size() or j < order_b.size()) {
+			bool take_a = j == order_b.size() or (i < order_a.size() and lower_a[order_a[i]] <= lower_b[order_b[j]]);
+			if (take_a) {
+				uint32_t a = order_a[i++];
+				prune(active_b, position_b, radius_b, lower_a[a]);
+				for (uint32_t b : active_b) {
+					if (Overlap(position_a[a], radius_a[a], position_b[b], radius_b[b])) pairs.push_back(SweepPair{ a, b });
+				}
+				active_a.push_back(a);
+			}
+			else {
+				uint32_t b = order_b[j++];
+				prune(active_a, position_a, radius_a, lower_b[b]);
+				for (uint32_t a : active_a) {
+					if (Overlap(position_a[a], radius_a[a], position_b[b], radius_b[b])) pairs.push_back(SweepPair{ a, b });
+				}
+				active_b.push_back(b);
+			}
+		}
+
+		std::sort(pairs.begin(), pairs.end(), [](const SweepPair& l, const SweepPair& r) {
+			return l.a != r.a ? l.a < r.a : l.b < r.b;
+		});
+		return pairs;
+	}
+};
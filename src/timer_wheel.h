@@ -0,0 +1,102 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+constexpr uint32_t TIMER_WHEEL_BUCKETS = 256;
+constexpr uint32_t TIMER_WHEEL_NONE = UINT32_MAX;
+
+// Calendar queue keyed on simulation tick. Insert appends to the bucket of
+// its tick, PopDue drains the buckets of the ticks that elapsed. Entries more
+// than one turn of the wheel ahead wait in their bucket until their turn
+// comes around. Within a tick entries come out in insertion order.
+//
+// Buckets are intrusive lists threaded through one node array, and popped
+// nodes go on a free list, so storage only grows with the peak entry count.
+template <typename T>
+struct TimerWheel {
+	struct Node {
+		uint32_t tick;
+		uint32_t next;
+		T payload;
+	};
+
+	struct Bucket {
+		uint32_t head = TIMER_WHEEL_NONE;
+		uint32_t tail = TIMER_WHEEL_NONE;
+	};
+
+	std::vector<Node> nodes;
+	std::vector<Bucket> buckets;
+	uint32_t free_head = TIMER_WHEEL_NONE;
+	uint32_t next_tick = 0;
+	size_t size = 0;
+
+	inline bool Empty(void) const {
+		return size == 0;
+	}
+
+	// ticks already popped are due on the next PopDue
+	void Insert(uint32_t tick, const T& payload) {
+		if (buckets.empty()) buckets.resize(TIMER_WHEEL_BUCKETS);
+		if (tick < next_tick) tick = next_tick;
+
+		uint32_t node = free_head;
+		if (node == TIMER_WHEEL_NONE) {
+			node = uint32_t(nodes.size());
+			nodes.push_back(Node{ tick, TIMER_WHEEL_NONE, payload });
+		}
+		else {
+			free_head = nodes[node].next;
+			nodes[node] = Node{ tick, TIMER_WHEEL_NONE, payload };
+		}
+
+		Bucket& bucket = buckets[tick % TIMER_WHEEL_BUCKETS];
+		if (bucket.tail == TIMER_WHEEL_NONE) {
+			bucket.head = node;
+		}
+		else {
+			nodes[bucket.tail].next = node;
+		}
+		bucket.tail = node;
+		size++;
+	}
+
+	// calls release(payload) for everything due up to and including now,
+	// release must not insert into this wheel
+	template <typename F>
+	void PopDue(uint32_t now, F release) {
+		for (; next_tick <= now; next_tick++) {
+			if (size == 0) {
+				next_tick = now + 1;
+				break;
+			}
+			Bucket& bucket = buckets[next_tick % TIMER_WHEEL_BUCKETS];
+			uint32_t kept_tail = TIMER_WHEEL_NONE;
+			uint32_t node = bucket.head;
+			bucket.head = TIMER_WHEEL_NONE;
+			while (node != TIMER_WHEEL_NONE) {
+				uint32_t next = nodes[node].next;
+				if (nodes[node].tick <= next_tick) {
+					release(nodes[node].payload);
+					nodes[node].next = free_head;
+					free_head = node;
+					size--;
+				}
+				else {
+					nodes[node].next = TIMER_WHEEL_NONE;
+					if (kept_tail == TIMER_WHEEL_NONE) {
+						bucket.head = node;
+					}
+					else {
+						nodes[kept_tail].next = node;
+					}
+					kept_tail = node;
+				}
+				node = next;
+			}
+			bucket.tail = kept_tail;
+		}
+	}
+};
@@ -0,0 +1,283 @@
+#pragma once
+
+#include "raylib.h"
+#include "raymath.h"
+
+#include <cstddef>
+#include <cstdint>
+
+#include "config.h"
+#include "interpolate_fn.h"
+
+#if defined(__AVX2__)
+#define BORNO_KERNELS_AVX2
+#endif
+#if defined(__SSE2__) or defined(_M_X64) or (defined(_M_IX86_FP) and _M_IX86_FP >= 2)
+#define BORNO_KERNELS_SSE2
+#endif
+
+#if defined(BORNO_KERNELS_AVX2) or defined(BORNO_KERNELS_SSE2)
+#include <immintrin.h>
+#endif
+
+// One run of bullets sharing a trajectory kind. Bezier kinds pass to/control
+// through velocity/acceleration and the curve parameter through t.
+// Every kernel rewrites position, stores the motion since the previous tick
+// and, unless kill is null, flags bullets that left the killing field.
+struct TrajectoryBatch {
+	const Vector2* from;
+	const Vector2* velocity;
+	const Vector2* acceleration;
+	const float* t;
+	Vector2* position;
+	Vector2* motion;
+	uint8_t* kill;
+	size_t count;
+	float inv_delta;
+};
+
+inline bool outside_killing_field(Vector2 position) {
+	return position.x < KILLING_FIELD_TOP_LEFT.x or
+		position.x > KILLING_FIELD_BOTTOM_RIGHT.x or
+		position.y < KILLING_FIELD_TOP_LEFT.y or
+		position.y > KILLING_FIELD_BOTTOM_RIGHT.y;
+}
+
+inline void store_batch_result(const TrajectoryBatch& batch, size_t i, Vector2 position) {
+	batch.motion[i] = Vector2Scale(Vector2Subtract(position, batch.position[i]), batch.inv_delta);
+	batch.position[i] = position;
+	if (batch.kill != nullptr) batch.kill[i] = outside_killing_field(position);
+}
+
+// scalar reference
+
+inline Vector2 linear_point(const TrajectoryBatch& batch, size_t i) {
+	return Vector2Add(batch.from[i], Vector2Scale(batch.velocity[i], batch.t[i]));
+}
+
+inline Vector2 accelerated_point(const TrajectoryBatch& batch, size_t i) {
+	float t = batch.t[i];
+	return Vector2Add(batch.from[i], Vector2Add(Vector2Scale(batch.velocity[i], t), Vector2Scale(batch.acceleration[i], 0.5f * t * t)));
+}
+
+inline Vector2 horizontal_bounce_point(const TrajectoryBatch& batch, size_t i) {
+	float t = batch.t[i];
+	return Vector2{ bounce_x(batch.from[i].x, batch.velocity[i].x, t), batch.from[i].y + batch.velocity[i].y * t };
+}
+
+inline Vector2 quadratic_bezier_point(const TrajectoryBatch& batch, size_t i) {
+	return bezier_point(batch.from[i], batch.velocity[i], batch.acceleration[i], batch.t[i]);
+}
+
+inline void linear_kernel_scalar(const TrajectoryBatch& batch, size_t begin = 0) {
+	for (size_t i = begin; i < batch.count; i++) store_batch_result(batch, i, linear_point(batch, i));
+}
+
+inline void accelerated_kernel_scalar(const TrajectoryBatch& batch, size_t begin = 0) {
+	for (size_t i = begin; i < batch.count; i++) store_batch_result(batch, i, accelerated_point(batch, i));
+}
+
+inline void horizontal_bounce_kernel_scalar(const TrajectoryBatch& batch, size_t begin = 0) {
+	for (size_t i = begin; i < batch.count; i++) store_batch_result(batch, i, horizontal_bounce_point(batch, i));
+}
+
+inline void quadratic_bezier_kernel_scalar(const TrajectoryBatch& batch, size_t begin = 0) {
+	for (size_t i = begin; i < batch.count; i++) store_batch_result(batch, i, quadratic_bezier_point(batch, i));
+}
+
+// SSE2, each register holds two interleaved Vector2, four bullets per iteration
+
+#if defined(BORNO_KERNELS_SSE2)
+
+inline __m128 sse2_load_pair(const Vector2* v) {
+	return _mm_loadu_ps(&v->x);
+}
+
+inline __m128 sse2_floor(__m128 v) {
+	__m128 truncated = _mm_cvtepi32_ps(_mm_cvttps_epi32(v));
+	return _mm_sub_ps(truncated, _mm_and_ps(_mm_cmpgt_ps(truncated, v), _mm_set1_ps(1.0f)));
+}
+
+// returns how many bullets were handled, the scalar kernel finishes the tail
+template <typename Eval>
+inline size_t run_kernel_sse2(const TrajectoryBatch& batch, Eval eval) {
+	const __m128 field_min = _mm_setr_ps(KILLING_FIELD_TOP_LEFT.x, KILLING_FIELD_TOP_LEFT.y, KILLING_FIELD_TOP_LEFT.x, KILLING_FIELD_TOP_LEFT.y);
+	const __m128 field_max = _mm_setr_ps(KILLING_FIELD_BOTTOM_RIGHT.x, KILLING_FIELD_BOTTOM_RIGHT.y, KILLING_FIELD_BOTTOM_RIGHT.x, KILLING_FIELD_BOTTOM_RIGHT.y);
+	const __m128 inv_delta = _mm_set1_ps(batch.inv_delta);
+	size_t i = 0;
+	for (; i + 4 <= batch.count; i += 4) {
+		__m128 t = _mm_loadu_ps(batch.t + i);
+		__m128 t_pairs[2] = { _mm_unpacklo_ps(t, t), _mm_unpackhi_ps(t, t) };
+		for (size_t h = 0; h < 2; h++) {
+			size_t j = i + 2 * h;
+			__m128 position = eval(j, t_pairs[h]);
+			__m128 motion = _mm_mul_ps(_mm_sub_ps(position, sse2_load_pair(batch.position + j)), inv_delta);
+			_mm_storeu_ps(&batch.motion[j].x, motion);
+			_mm_storeu_ps(&batch.position[j].x, position);
+			if (batch.kill == nullptr) continue;
+			int outside = _mm_movemask_ps(_mm_or_ps(_mm_cmplt_ps(position, field_min), _mm_cmpgt_ps(position, field_max)));
+			batch.kill[j] = (outside & 0x3) != 0;
+			batch.kill[j + 1] = (outside & 0xC) != 0;
+		}
+	}
+	return i;
+}
+
+inline void linear_kernel_sse2(const TrajectoryBatch& batch) {
+	size_t done = run_kernel_sse2(batch, [&](size_t j, __m128 t) {
+		return _mm_add_ps(sse2_load_pair(batch.from + j), _mm_mul_ps(sse2_load_pair(batch.velocity + j), t));
+	});
+	linear_kernel_scalar(batch, done);
+}
+
+inline void accelerated_kernel_sse2(const TrajectoryBatch& batch) {
+	const __m128 half = _mm_set1_ps(0.5f);
+	size_t done = run_kernel_sse2(batch, [&](size_t j, __m128 t) {
+		__m128 velocity = _mm_add_ps(sse2_load_pair(batch.velocity + j), _mm_mul_ps(_mm_mul_ps(sse2_load_pair(batch.acceleration + j), half), t));
+		return _mm_add_ps(sse2_load_pair(batch.from + j), _mm_mul_ps(velocity, t));
+	});
+	accelerated_kernel_scalar(batch, done);
+}
+
+inline void horizontal_bounce_kernel_sse2(const TrajectoryBatch& batch) {
+	const __m128 x_lanes = _mm_castsi128_ps(_mm_setr_epi32(-1, 0, -1, 0));
+	const __m128 left = _mm_set1_ps(PLAYING_FIELD_TOP_LEFT.x);
+	const __m128 width = _mm_set1_ps(PLAYING_FIELD_RECT.width);
+	const __m128 period = _mm_set1_ps(2.0f * PLAYING_FIELD_RECT.width);
+	const __m128 inv_period = _mm_set1_ps(1.0f / (2.0f * PLAYING_FIELD_RECT.width));
+	const __m128 abs_mask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+	size_t done = run_kernel_sse2(batch, [&](size_t j, __m128 t) {
+		__m128 straight = _mm_add_ps(sse2_load_pair(batch.from + j), _mm_mul_ps(sse2_load_pair(batch.velocity + j), t));
+		__m128 distance = _mm_sub_ps(straight, left);
+		__m128 phase = _mm_sub_ps(distance, _mm_mul_ps(period, sse2_floor(_mm_mul_ps(distance, inv_period))));
+		__m128 bounced = _mm_sub_ps(_mm_add_ps(left, width), _mm_and_ps(_mm_sub_ps(phase, width), abs_mask));
+		return _mm_or_ps(_mm_and_ps(x_lanes, bounced), _mm_andnot_ps(x_lanes, straight));
+	});
+	horizontal_bounce_kernel_scalar(batch, done);
+}
+
+inline void quadratic_bezier_kernel_sse2(const TrajectoryBatch& batch) {
+	const __m128 one = _mm_set1_ps(1.0f);
+	const __m128 two = _mm_set1_ps(2.0f);
+	size_t done = run_kernel_sse2(batch, [&](size_t j, __m128 u) {
+		__m128 v = _mm_sub_ps(one, u);
+		__m128 from_weight = _mm_mul_ps(v, v);
+		__m128 control_weight = _mm_mul_ps(two, _mm_mul_ps(u, v));
+		__m128 to_weight = _mm_mul_ps(u, u);
+		return _mm_add_ps(_mm_add_ps(_mm_mul_ps(sse2_load_pair(batch.from + j), from_weight),
+			_mm_mul_ps(sse2_load_pair(batch.acceleration + j), control_weight)),
+			_mm_mul_ps(sse2_load_pair(batch.velocity + j), to_weight));
+	});
+	quadratic_bezier_kernel_scalar(batch, done);
+}
+
+#endif
+
+// AVX2, each register holds four interleaved Vector2, eight bullets per iteration
+
+#if defined(BORNO_KERNELS_AVX2)
+
+inline __m256 avx2_load_quad(const Vector2* v) {
+	return _mm256_loadu_ps(&v->x);
+}
+
+template <typename Eval>
+inline size_t run_kernel_avx2(const TrajectoryBatch& batch, Eval eval) {
+	const __m256 field_min = _mm256_setr_ps(KILLING_FIELD_TOP_LEFT.x, KILLING_FIELD_TOP_LEFT.y, KILLING_FIELD_TOP_LEFT.x, KILLING_FIELD_TOP_LEFT.y,
+		KILLING_FIELD_TOP_LEFT.x, KILLING_FIELD_TOP_LEFT.y, KILLING_FIELD_TOP_LEFT.x, KILLING_FIELD_TOP_LEFT.y);
+	const __m256 field_max = _mm256_setr_ps(KILLING_FIELD_BOTTOM_RIGHT.x, KILLING_FIELD_BOTTOM_RIGHT.y, KILLING_FIELD_BOTTOM_RIGHT.x, KILLING_FIELD_BOTTOM_RIGHT.y,
+		KILLING_FIELD_BOTTOM_RIGHT.x, KILLING_FIELD_BOTTOM_RIGHT.y, KILLING_FIELD_BOTTOM_RIGHT.x, KILLING_FIELD_BOTTOM_RIGHT.y);
+	const __m256 inv_delta = _mm256_set1_ps(batch.inv_delta);
+	const __m256i low_pairs = _mm256_setr_epi32(0, 0, 1, 1, 2, 2, 3, 3);
+	const __m256i high_pairs = _mm256_setr_epi32(4, 4, 5, 5, 6, 6, 7, 7);
+	size_t i = 0;
+	for (; i + 8 <= batch.count; i += 8) {
+		__m256 t = _mm256_loadu_ps(batch.t + i);
+		__m256 t_pairs[2] = { _mm256_permutevar8x32_ps(t, low_pairs), _mm256_permutevar8x32_ps(t, high_pairs) };
+		for (size_t h = 0; h < 2; h++) {
+			size_t j = i + 4 * h;
+			__m256 position = eval(j, t_pairs[h]);
+			__m256 motion = _mm256_mul_ps(_mm256_sub_ps(position, avx2_load_quad(batch.position + j)), inv_delta);
+			_mm256_storeu_ps(&batch.motion[j].x, motion);
+			_mm256_storeu_ps(&batch.position[j].x, position);
+			if (batch.kill == nullptr) continue;
+			int outside = _mm256_movemask_ps(_mm256_or_ps(_mm256_cmp_ps(position, field_min, _CMP_LT_OQ), _mm256_cmp_ps(position, field_max, _CMP_GT_OQ)));
+			for (size_t k = 0; k < 4; k++) {
+				batch.kill[j + k] = ((outside >> (2 * k)) & 0x3) != 0;
+			}
+		}
+	}
+	return i;
+}
+
+inline void linear_kernel_avx2(const TrajectoryBatch& batch) {
+	size_t done = run_kernel_avx2(batch, [&](size_t j, __m256 t) {
+		return _mm256_add_ps(avx2_load_quad(batch.from + j), _mm256_mul_ps(avx2_load_quad(batch.velocity + j), t));
+	});
+	linear_kernel_scalar(batch, done);
+}
+
+inline void accelerated_kernel_avx2(const TrajectoryBatch& batch) {
+	const __m256 half = _mm256_set1_ps(0.5f);
+	size_t done = run_kernel_avx2(batch, [&](size_t j, __m256 t) {
+		__m256 velocity = _mm256_add_ps(avx2_load_quad(batch.velocity + j), _mm256_mul_ps(_mm256_mul_ps(avx2_load_quad(batch.acceleration + j), half), t));
+		return _mm256_add_ps(avx2_load_quad(batch.from + j), _mm256_mul_ps(velocity, t));
+	});
+	accelerated_kernel_scalar(batch, done);
+}
+
+inline void horizontal_bounce_kernel_avx2(const TrajectoryBatch& batch) {
+	const __m256 x_lanes = _mm256_castsi256_ps(_mm256_setr_epi32(-1, 0, -1, 0, -1, 0, -1, 0));
+	const __m256 left = _mm256_set1_ps(PLAYING_FIELD_TOP_LEFT.x);
+	const __m256 width = _mm256_set1_ps(PLAYING_FIELD_RECT.width);
+	const __m256 period = _mm256_set1_ps(2.0f * PLAYING_FIELD_RECT.width);
+	const __m256 inv_period = _mm256_set1_ps(1.0f / (2.0f * PLAYING_FIELD_RECT.width));
+	const __m256 abs_mask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+	size_t done = run_kernel_avx2(batch, [&](size_t j, __m256 t) {
+		__m256 straight = _mm256_add_ps(avx2_load_quad(batch.from + j), _mm256_mul_ps(avx2_load_quad(batch.velocity + j), t));
+		__m256 distance = _mm256_sub_ps(straight, left);
+		__m256 phase = _mm256_sub_ps(distance, _mm256_mul_ps(period, _mm256_floor_ps(_mm256_mul_ps(distance, inv_period))));
+		__m256 bounced = _mm256_sub_ps(_mm256_add_ps(left, width), _mm256_and_ps(_mm256_sub_ps(phase, width), abs_mask));
+		return _mm256_blendv_ps(straight, bounced, x_lanes);
+	});
+	horizontal_bounce_kernel_scalar(batch, done);
+}
+
+inline void quadratic_bezier_kernel_avx2(const TrajectoryBatch& batch) {
+	const __m256 one = _mm256_set1_ps(1.0f);
+	const __m256 two = _mm256_set1_ps(2.0f);
+	size_t done = run_kernel_avx2(batch, [&](size_t j, __m256 u) {
+		__m256 v = _mm256_sub_ps(one, u);
+		__m256 from_weight = _mm256_mul_ps(v, v);
+		__m256 control_weight = _mm256_mul_ps(two, _mm256_mul_ps(u, v));
+		__m256 to_weight = _mm256_mul_ps(u, u);
+		return _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(avx2_load_quad(batch.from + j), from_weight),
+			_mm256_mul_ps(avx2_load_quad(batch.acceleration + j), control_weight)),
+			_mm256_mul_ps(avx2_load_quad(batch.velocity + j), to_weight));
+	});
+	quadratic_bezier_kernel_scalar(batch, done);
+}
+
+#endif
+
+// best kernel set this build was compiled for
+
+#if defined(BORNO_KERNELS_AVX2)
+constexpr const char* TRAJECTORY_KERNEL_ISA = "avx2";
+inline void linear_kernel(const TrajectoryBatch& batch) { linear_kernel_avx2(batch); }
+inline void accelerated_kernel(const TrajectoryBatch& batch) { accelerated_kernel_avx2(batch); }
+inline void horizontal_bounce_kernel(const TrajectoryBatch& batch) { horizontal_bounce_kernel_avx2(batch); }
+inline void quadratic_bezier_kernel(const TrajectoryBatch& batch) { quadratic_bezier_kernel_avx2(batch); }
+#elif defined(BORNO_KERNELS_SSE2)
+constexpr const char* TRAJECTORY_KERNEL_ISA = "sse2";
+inline void linear_kernel(const TrajectoryBatch& batch) { linear_kernel_sse2(batch); }
+inline void accelerated_kernel(const TrajectoryBatch& batch) { accelerated_kernel_sse2(batch); }
+inline void horizontal_bounce_kernel(const TrajectoryBatch& batch) { horizontal_bounce_kernel_sse2(batch); }
+inline void quadratic_bezier_kernel(const TrajectoryBatch& batch) { quadratic_bezier_kernel_sse2(batch); }
+#else
+constexpr const char* TRAJECTORY_KERNEL_ISA = "scalar";
+inline void linear_kernel(const TrajectoryBatch& batch) { linear_kernel_scalar(batch); }
+inline void accelerated_kernel(const TrajectoryBatch& batch) { accelerated_kernel_scalar(batch); }
+inline void horizontal_bounce_kernel(const TrajectoryBatch& batch) { horizontal_bounce_kernel_scalar(batch); }
+inline void quadratic_bezier_kernel(const TrajectoryBatch& batch) { quadratic_bezier_kernel_scalar(batch); }
+#endif
@@ -0,0 +1,132 @@
+#pragma once
+
+#include "raylib.h"
+#include "raymath.h"
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+#include "slot_map.h"
+
+constexpr uint32_t TRANSFORM_NO_PARENT = UINT32_MAX;
+
+// Parent/child offsets resolved into world positions once per tick.
+// Nodes live in flat arrays in topological order: a node is created after
+// its parent and compaction keeps the order, so Resolve is one forward pass
+// where every parent is already done. Handles are generational like SlotMap
+// handles. Destroying a node takes its whole subtree with it on the next
+// Resolve.
+struct TransformSystem {
+	struct Slot {
+		uint32_t dense;
+		uint32_t generation;
+	};
+
+	std::vector<uint32_t> parent;
+	std::vector<Vector2> local;
+	std::vector<Vector2> world;
+	std::vector<uint8_t> dead;
+	std::vector<uint32_t> dense_slot;
+	std::vector<Slot> slots;
+	std::vector<uint32_t> free_slots;
+	std::vector<uint32_t> remap;
+
+	inline size_t Size(void) const {
+		return parent.size();
+	}
+
+	void Reserve(size_t capacity) {
+		parent.reserve(capacity);
+		local.reserve(capacity);
+		world.reserve(capacity);
+		dead.reserve(capacity);
+		dense_slot.reserve(capacity);
+		slots.reserve(capacity);
+		free_slots.reserve(capacity);
+		remap.reserve(capacity);
+	}
+
+	inline bool Contains(SlotHandle handle) const {
+		return not handle.IsNull() and handle.Index() < slots.size() and slots[handle.Index()].generation == handle.Generation();
+	}
+
+	inline void BumpGeneration(uint32_t slot) {
+		uint32_t generation = (slots[slot].generation + 1) & SLOT_MAP_GENERATION_MASK;
+		slots[slot].generation = generation == 0 ? 1 : generation;
+	}
+
+	// a root when parent_handle is null or stale, world is valid right away
+	SlotHandle Create(Vector2 offset, SlotHandle parent_handle = {}) {
+		uint32_t slot;
+		if (free_slots.empty()) {
+			slot = uint32_t(slots.size());
+			slots.push_back(Slot{ 0, 1 });
+		}
+		else {
+			slot = free_slots.back();
+			free_slots.pop_back();
+		}
+
+		uint32_t parent_dense = Contains(parent_handle) ? slots[parent_handle.Index()].dense : TRANSFORM_NO_PARENT;
+		slots[slot].dense = uint32_t(Size());
+		parent.push_back(parent_dense);
+		local.push_back(offset);
+		world.push_back(parent_dense == TRANSFORM_NO_PARENT ? offset : Vector2Add(world[parent_dense], offset));
+		dead.push_back(0);
+		dense_slot.push_back(slot);
+		return SlotHandle{ slots[slot].generation << SLOT_MAP_INDEX_BITS | slot };
+	}
+
+	// the handle goes stale at once, the node and its descendants leave on the next Resolve
+	void Destroy(SlotHandle handle) {
+		if (not Contains(handle)) return;
+		dead[slots[handle.Index()].dense] = 1;
+		BumpGeneration(handle.Index());
+	}
+
+	// offset from the parent, or the world position of a root
+	inline void SetLocal(SlotHandle handle, Vector2 offset) {
+		if (Contains(handle)) local[slots[handle.Index()].dense] = offset;
+	}
+
+	// as of the last Resolve, or Create for nodes made since
+	inline Vector2 World(SlotHandle handle) const {
+		return Contains(handle) ? world[slots[handle.Index()].dense] : Vector2Zero();
+	}
+
+	void Resolve(void) {
+		remap.resize(Size());
+		size_t kept = 0;
+		for (size_t i = 0; i < Size(); i++) {
+			// dead[p] may already hold a kept node moved down over it, remap[p] says whether p was removed
+			uint32_t p = parent[i];
+			if (not dead[i] and p != TRANSFORM_NO_PARENT and remap[p] == TRANSFORM_NO_PARENT) {
+				// a descendant of a destroyed node, its handle was still current
+				dead[i] = 1;
+				BumpGeneration(dense_slot[i]);
+			}
+			if (dead[i]) {
+				remap[i] = TRANSFORM_NO_PARENT;
+				slots[dense_slot[i]].dense = TRANSFORM_NO_PARENT;
+				free_slots.push_back(dense_slot[i]);
+				continue;
+			}
+
+			uint32_t kept_parent = p == TRANSFORM_NO_PARENT ? TRANSFORM_NO_PARENT : remap[p];
+			remap[i] = uint32_t(kept);
+			parent[kept] = kept_parent;
+			local[kept] = local[i];
+			dead[kept] = 0;
+			dense_slot[kept] = dense_slot[i];
+			slots[dense_slot[kept]].dense = uint32_t(kept);
+			world[kept] = kept_parent == TRANSFORM_NO_PARENT ? local[kept] : Vector2Add(world[kept_parent], local[kept]);
+			kept++;
+		}
+		parent.resize(kept);
+		local.resize(kept);
+		world.resize(kept);
+		dead.resize(kept);
+		dense_slot.resize(kept);
+	}
+};
@@ -0,0 +1,90 @@
+#include "raylib.h"
+#include "raymath.h"
+
+#include <cstdio>
+
+#include "config.h"
+#include "game.h"
+
+// Emitters attached below a destructible through Game::AttachEmitter stop
+// firing once that destructible is destroyed, including shots they had
+// already scheduled.
+//
+//   borno_test_game
+//
+// Prints each failed check and exits with status 1 if there was any.
+
+constexpr float TEST_TICK = 1.0f / DEFAULT_SIMULATION_TICK_RATE;
+constexpr float TEST_STREAM_INTERVAL = 0.05f;
+constexpr float TEST_STREAM_LENGTH = 5.0f;
+
+static int failures = 0;
+
+static void check(bool condition, const char* what) {
+	if (not condition) {
+		std::printf("FAIL %s\n", what);
+		failures++;
+	}
+}
+
+// schedules every shot of a long stream on its first call, motionless so they stay in the pool
+static SpawnFn stream(Color color) {
+	return [=](float et, float dt, Vector2 ep, Vector2 pp, SpawnSink sink) -> float {
+		if (et == 0.0f) {
+			for (float t = TEST_STREAM_INTERVAL; t < TEST_STREAM_LENGTH; t += TEST_STREAM_INTERVAL) {
+				sink(ProjectileSpawner{ t, Projectile{ BASIC_ENEMY_SHOT_RADIUS, color, linear(ep, Vector2Zero()) } });
+			}
+		}
+		return 2.0f * TEST_STREAM_LENGTH;
+	};
+}
+
+static size_t count_color(const ProjectilePool& pool, Color color) {
+	size_t count = 0;
+	for (size_t i = 0; i < pool.Size(); i++) {
+		const Color& c = pool.color[i];
+		if (c.r == color.r and c.g == color.g and c.b == color.b and c.a == color.a) count++;
+	}
+	return count;
+}
+
+static Destructible part_at(Vector2 position) {
+	return Destructible{ POPCORN_RADIUS, BLUE, linear(position, Vector2Zero()), 1 << 30 };
+}
+
+static void run(Game& game, float seconds) {
+	for (float t = 0.0f; t < seconds; t += TEST_TICK) game.Update(TEST_TICK, PlayerInput{});
+}
+
+// a turret on a boss part and one on an unrelated destructible, the part is destroyed mid-stream
+static void destroyed_part_silences_its_turret(void) {
+	Game game(std::vector<DestructibleSpawner>{});
+	Vector2 center{ PLAYING_FIELD_RECT.x + PLAYING_FIELD_RECT.width * 0.5f, PLAYING_FIELD_RECT.y + PLAYING_FIELD_RECT.height * 0.25f };
+
+	SlotHandle part = game.AddDestructible(part_at(center));
+	game.AttachEmitter(game.destructibles.Get(part)->transform, stream(ORANGE), Vector2{ 20.0f, 0.0f });
+	SlotHandle other = game.AddDestructible(part_at(Vector2Add(center, Vector2{ 0.0f, 100.0f })));
+	game.AttachEmitter(game.destructibles.Get(other)->transform, stream(GREEN), Vector2Zero());
+
+	run(game, 1.0f);
+	size_t turret_before = count_color(game.enemy_projectiles, ORANGE);
+	size_t other_before = count_color(game.enemy_projectiles, GREEN);
+	check(turret_before > 0, "turret fires while its part is alive");
+
+	// dies in Collide, its subtree goes on the Resolve at the end of the same tick
+	game.destructibles.Get(part)->health = 0;
+	game.Update(TEST_TICK, PlayerInput{});
+	size_t turret_at_death = count_color(game.enemy_projectiles, ORANGE);
+
+	run(game, 2.0f);
+	check(not game.destructibles.Contains(part), "part is removed");
+	check(count_color(game.enemy_projectiles, ORANGE) == turret_at_death, "no turret shots after its part is destroyed");
+	check(count_color(game.enemy_projectiles, GREEN) > other_before, "unrelated emitter keeps firing");
+	check(game.emitters.Size() == 1, "turret emitter is removed");
+}
+
+int main(void) {
+	destroyed_part_silences_its_turret();
+	if (failures == 0) std::printf("game checks passed\n");
+	return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,97 @@
+#include "raylib.h"
+#include "raymath.h"
+
+#include <cstdio>
+
+#include "transform.h"
+
+// TransformSystem::Resolve removing subtrees when live nodes sit between a
+// destroyed node and its descendants in the dense arrays.
+//
+//   borno_test_transform
+//
+// Prints each failed check and exits with status 1 if there was any.
+
+static int failures = 0;
+
+static void check(bool condition, const char* what) {
+	if (not condition) {
+		std::printf("FAIL %s\n", what);
+		failures++;
+	}
+}
+
+static bool near(Vector2 a, Vector2 b) {
+	return Vector2Distance(a, b) < 1e-4f;
+}
+
+// roots a and b, a child of a after b
+static void destroyed_parent_with_interleaved_root(void) {
+	TransformSystem transforms;
+	SlotHandle a = transforms.Create(Vector2{ 100.0f, 0.0f });
+	SlotHandle b = transforms.Create(Vector2{ 500.0f, 0.0f });
+	SlotHandle child = transforms.Create(Vector2{ 10.0f, 0.0f }, a);
+
+	transforms.Destroy(a);
+	transforms.Resolve();
+
+	check(not transforms.Contains(a), "destroyed root is gone");
+	check(not transforms.Contains(child), "child of a destroyed root is gone");
+	check(transforms.Contains(b), "unrelated root is kept");
+	check(near(transforms.World(b), Vector2{ 500.0f, 0.0f }), "unrelated root keeps its position");
+	check(transforms.Size() == 1, "only the unrelated root is left");
+}
+
+// a - child - grandchild with b and b's child in between, a destroyed
+static void destroyed_parent_with_grandchild(void) {
+	TransformSystem transforms;
+	SlotHandle a = transforms.Create(Vector2{ 100.0f, 0.0f });
+	SlotHandle b = transforms.Create(Vector2{ 500.0f, 0.0f });
+	SlotHandle child = transforms.Create(Vector2{ 10.0f, 0.0f }, a);
+	SlotHandle b_child = transforms.Create(Vector2{ 0.0f, 20.0f }, b);
+	SlotHandle grandchild = transforms.Create(Vector2{ 1.0f, 0.0f }, child);
+
+	transforms.Destroy(a);
+	transforms.Resolve();
+
+	check(not transforms.Contains(child), "child is gone");
+	check(not transforms.Contains(grandchild), "grandchild is gone");
+	check(transforms.Contains(b_child), "child of the unrelated root is kept");
+	check(near(transforms.World(b_child), Vector2{ 500.0f, 20.0f }), "child of the unrelated root keeps its parent");
+
+	transforms.SetLocal(b, Vector2{ 300.0f, 0.0f });
+	transforms.Resolve();
+	check(near(transforms.World(b_child), Vector2{ 300.0f, 20.0f }), "child of the unrelated root follows it");
+	check(transforms.Size() == 2, "only the unrelated subtree is left");
+}
+
+// a destroyed child takes its own children but leaves its parent and siblings
+static void destroyed_middle_node(void) {
+	TransformSystem transforms;
+	SlotHandle a = transforms.Create(Vector2{ 100.0f, 0.0f });
+	SlotHandle child = transforms.Create(Vector2{ 10.0f, 0.0f }, a);
+	SlotHandle sibling = transforms.Create(Vector2{ 0.0f, 10.0f }, a);
+	SlotHandle grandchild = transforms.Create(Vector2{ 1.0f, 0.0f }, child);
+	SlotHandle nephew = transforms.Create(Vector2{ 0.0f, 1.0f }, sibling);
+
+	transforms.Destroy(child);
+	transforms.Resolve();
+
+	check(transforms.Contains(a), "parent is kept");
+	check(not transforms.Contains(grandchild), "child of the destroyed node is gone");
+	check(near(transforms.World(sibling), Vector2{ 100.0f, 10.0f }), "sibling keeps its parent");
+	check(near(transforms.World(nephew), Vector2{ 100.0f, 11.0f }), "sibling's child keeps its parent");
+
+	// reused slots must not revive old handles or attach to stale parents
+	SlotHandle fresh = transforms.Create(Vector2{ 5.0f, 0.0f }, child);
+	check(not transforms.Contains(child), "old handle stays stale after reuse");
+	check(near(transforms.World(fresh), Vector2{ 5.0f, 0.0f }), "stale parent makes a root");
+}
+
+int main(void) {
+	destroyed_parent_with_interleaved_root();
+	destroyed_parent_with_grandchild();
+	destroyed_middle_node();
+	if (failures == 0) std::printf("transform checks passed\n");
+	return failures == 0 ? 0 : 1;
+}